@@ -169,6 +169,7 @@ namespace {
         std::cout << "  -config FILE: use FILE instead of default configuration file\n";
         std::cout << "  -confdir : indicates where the configuration files are located\n";
         std::cout << "  -noconfig: no configuration file is used\n";
+        std::cout << "  -stream: reads the source file by windows, for huge files\n";
         std::cout << "  -interactivemath: reads from the terminal, \n";
         std::cout << "      and prints math formulas on the terminal\n";
         std::cout << "  -utf8: says that the source is encoded in utf8 instead of latin1\n";
@@ -371,7 +372,10 @@ void MainClass::check_for_input() {
         exit(1);
     }
     open_log();
-    tralics_ns::read_a_file(input_content, s, 4);
+    if (stream_input)
+        tralics_ns::stream_a_file(input_content, s);
+    else
+        tralics_ns::read_a_file(input_content, s, 4);
     if (input_content.empty()) {
         log_and_tty << "Empty input file " << s << "\n";
         exit(1);
@@ -695,6 +699,8 @@ void MainClass::parse_option(int &p, int argc, char **argv) {
         no_undef_mac = true;
     else if (strcmp(s, "noconfig") == 0)
         noconfig = true;
+    else if (strcmp(s, "stream") == 0)
+        stream_input = true;
     else if (strcmp(s, "compatibility") == 0)
         compatibility = true;
     else if (strcmp(s, "oldphi") == 0)
@@ -934,7 +940,7 @@ void MainClass::read_config_and_other() {
     LinePtr TP = config_file.parse_and_extract("TitlePage");
     tralics_ns::Titlepage_create(TP);
     if (have_dclass && !handling_ra) from_config.insert("\\InputIfFileExists*+{" + ult_name + "}{}{}\n", true);
-    input_content.splice(doc_class_pos, from_config);
+    input_content.splice_at(doc_class_pos, from_config);
     config_file.clear();
 }
 
@@ -1023,6 +1029,10 @@ void MainClass::boot_bibtex(bool inra) {
 }
 
 void MainClass::show_input_size() {
+    if (input_content.stream) {
+        the_log << "The input file is read by windows\n";
+        return;
+    }
     int n = input_content.get_last_line_no();
     if (n == 1)
         the_log << "There is a single line\n";
@@ -1,6 +1,7 @@
 #include "tralics/globals.h"
 #include "txinline.h"
 #include "txparser.h"
+#include <unordered_map>
 
 std::vector<std::string> conf_path;
 std::vector<std::string> input_path;
@@ -26,21 +27,27 @@ bool seen_enddocument{false};
 std::array<std::array<codepoint, lmaxchar>, max_encoding - 2> custom_table;
 
 namespace {
+    std::unordered_map<std::string, size_t> pool_index; // position in file_pool of a file, by name
+
     /// Look for a file in the pool
     auto search_in_pool(const std::string &name) -> std::optional<size_t> {
-        for (size_t i = 0; i < file_pool.size(); i++)
-            if (file_pool[i]->file_name == name) return i;
-        return {};
+        auto it = pool_index.find(name);
+        if (it == pool_index.end()) return {};
+        return it->second;
     }
 } // namespace
 
-void main_ns::register_file(LinePtr *x) { file_pool.push_back(x); }
+// If the name is already in the pool, the first file wins.
+void main_ns::register_file(LinePtr *x) {
+    pool_index.try_emplace(x->file_name, file_pool.size());
+    file_pool.push_back(x);
+}
 
 auto tralics_ns::find_in_confdir(const std::string &s, bool retry) -> bool {
     main_ns::path_buffer << bf_reset << s;
     pool_position = search_in_pool(s);
     if (pool_position) return true;
-    if (file_exists(main_ns::path_buffer)) return true;
+    if (file_exists(main_ns::path_buffer, "", s)) return true;
     if (!retry) return false;
     if (s.empty() || s[0] == '.' || s[0] == '/') return false;
     return main_ns::search_in_confdir(s);
@@ -50,7 +57,7 @@ auto main_ns::search_in_confdir(const std::string &s) -> bool {
     auto n = conf_path.size();
     for (auto i = n; i != 0; i--) {
         main_ns::path_buffer << bf_reset << conf_path[i - 1] << bf_optslash << s;
-        if (tralics_ns::file_exists(main_ns::path_buffer)) return true;
+        if (tralics_ns::file_exists(main_ns::path_buffer, conf_path[i - 1], s)) return true;
     }
     return false;
 }
@@ -66,7 +73,7 @@ auto tralics_ns::find_in_path(const std::string &s) -> bool {
             main_ns::path_buffer << bf_reset << s;
         else
             main_ns::path_buffer << bf_reset << p << bf_optslash << s;
-        if (file_exists(main_ns::path_buffer)) return true;
+        if (file_exists(main_ns::path_buffer, p, s)) return true;
     }
     return false;
 }
@@ -1129,7 +1129,7 @@ void Parser::load_latex() {
     more_bootstrap();
     LinePtr L;
     L.insert("%% Begin bootstrap commands for latex");
-    eqtb_int_table[uchar('@')].val = 11; // this is \makeatletter
+    catcodes[uchar('@')].val = 11; // this is \makeatletter
     // initialise counters, dimen etc
     L.insert("\\@flushglue = 0pt plus 1fil");
     L.insert("\\hideskip =-1000pt plus 1fill");
@@ -1208,7 +1208,7 @@ void Parser::load_latex() {
     init(L);
     translate0();
 
-    eqtb_int_table[uchar('@')].val = 12; // this is \makeatother
+    catcodes[uchar('@')].val = 12; // this is \makeatother
     TokenList ejob                 = toks_registers[everyjob_code].val;
     back_input(ejob);
 }
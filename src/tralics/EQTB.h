@@ -1,5 +1,7 @@
 #pragma once
 #include "../txscaled.h"
+#include <array>
+#include <memory>
 
 class Xml;
 
@@ -18,5 +20,36 @@ using EqtbInt    = EQTB<long>;
 using EqtbString = EQTB<std::string>;
 using EqtbDim    = EQTB<ScaledInt>;
 using EqtbGlue   = EQTB<Glue>;
-using EqtbToken  = EQTB<TokenList>;
+using EqtbToken  = EQTB<SharedTokenList>;
 using EqtbBox    = EQTB<Xml *>;
+
+// A table of catcodes, for \initcatcodetable and \savecatcodetable.
+using CatcodeTable = std::array<EqtbInt, nb_characters>;
+
+// The table of integers. It holds six tables indexed by characters, but
+// only the catcodes are contiguous (see Parser::catcodes); the other
+// entries are allocated by pages, on first use, as most are never used.
+template <size_t N> class EqtbIntTable {
+    static constexpr size_t page_size = 256;
+    using Page                        = std::array<EqtbInt, page_size>;
+
+    CatcodeTable                                                         cat;
+    std::array<std::unique_ptr<Page>, (N - nb_characters) / page_size + 1> pages;
+
+public:
+    auto data() -> EqtbInt * { return cat.data(); }
+
+    auto operator[](size_t k) -> EqtbInt & {
+        if (k < nb_characters) return cat[k];
+        auto &p = pages[(k - nb_characters) / page_size];
+        if (!p) p = std::make_unique<Page>();
+        return (*p)[(k - nb_characters) % page_size];
+    }
+
+    auto operator[](size_t k) const -> const EqtbInt & {
+        static const EqtbInt unused;
+        if (k < nb_characters) return cat[k];
+        const auto &p = pages[(k - nb_characters) / page_size];
+        return p ? (*p)[(k - nb_characters) % page_size] : unused;
+    }
+};
@@ -37,6 +37,7 @@ class MainClass {
 
     bool find_words{false};
     bool noconfig{false};
+    bool stream_input{false}; // read the main file by windows ?
     bool nomathml{false};
     bool dualmath{false};
     bool silent{false}; // are we silent ?
@@ -0,0 +1,90 @@
+#pragma once
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+// A free-list allocator for the small blocks used by token lists and math
+// lists. Blocks are grouped in size classes (multiples of 16 bytes, up to
+// 512). A freed block goes to the list of its class and is reused by the
+// next request of the same class; new blocks are cut from 64K chunks, that
+// are never given back. Larger requests go to the global allocator.
+// Tralics is single-threaded, so there is no locking.
+class NodePool {
+    static constexpr size_t grain      = 16;
+    static constexpr size_t nb_classes = 32;
+    static constexpr size_t chunk_size = 1 << 16;
+
+    struct FreeNode {
+        FreeNode *next;
+    };
+
+    static inline FreeNode *free_list[nb_classes]{};
+    static inline char *    arena{nullptr};
+    static inline size_t    arena_left{0};
+
+    static void push(void *p, size_t k) {
+        auto *q      = static_cast<FreeNode *>(p);
+        q->next      = free_list[k];
+        free_list[k] = q;
+    }
+
+public:
+    static inline size_t hits{0};   ///< requests served by a free list
+    static inline size_t misses{0}; ///< requests served by the arena or malloc
+    static inline size_t live{0};   ///< blocks in use
+    static inline size_t peak{0};   ///< maximal value of live
+
+    static auto get(size_t n) -> void * {
+        if (++live > peak) peak = live;
+        auto k = n == 0 ? 0 : (n - 1) / grain;
+        if (k >= nb_classes) {
+            ++misses;
+            return ::operator new(n);
+        }
+        if (auto *p = free_list[k]) {
+            ++hits;
+            free_list[k] = p->next;
+            return p;
+        }
+        ++misses;
+        auto sz = (k + 1) * grain;
+        if (arena_left < sz) {
+            if (arena_left >= grain) push(arena, arena_left / grain - 1);
+            arena      = static_cast<char *>(::operator new(chunk_size));
+            arena_left = chunk_size;
+        }
+        auto *res = arena;
+        arena += sz;
+        arena_left -= sz;
+        return res;
+    }
+
+    static void put(void *p, size_t n) noexcept {
+        --live;
+        auto k = n == 0 ? 0 : (n - 1) / grain;
+        if (k >= nb_classes)
+            ::operator delete(p);
+        else
+            push(p, k);
+    }
+};
+
+// Standard allocator interface on top of NodePool.
+template <typename T> struct PoolAllocator {
+    static_assert(alignof(T) <= 16, "NodePool blocks are 16-byte aligned");
+    using value_type      = T;
+    using is_always_equal = std::true_type;
+
+    PoolAllocator() = default;
+    template <typename U> PoolAllocator(const PoolAllocator<U> & /*unused*/) noexcept {}
+
+    auto allocate(size_t n) -> T * { return static_cast<T *>(NodePool::get(n * sizeof(T))); }
+    void deallocate(T *p, size_t n) noexcept { NodePool::put(p, n * sizeof(T)); }
+};
+
+template <typename T, typename U> auto operator==(const PoolAllocator<T> & /*unused*/, const PoolAllocator<U> & /*unused*/) -> bool {
+    return true;
+}
+template <typename T, typename U> auto operator!=(const PoolAllocator<T> & /*unused*/, const PoolAllocator<U> & /*unused*/) -> bool {
+    return false;
+}
@@ -1,6 +1,11 @@
 #pragma once
 #include "CmdChr.h"
+#include "NodePool.h"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
 #include <list>
+#include <vector>
 
 struct Token {
     size_t val{0};
@@ -55,6 +60,7 @@ struct Token {
     [[nodiscard]] auto is_valid() const -> bool { return val != 0; }
     [[nodiscard]] auto not_a_cmd() const -> bool { return val < eqtb_offset; }
     [[nodiscard]] auto is_a_char() const -> bool { return val < eqtb_offset; }
+    [[nodiscard]] auto is_out_param() const -> bool { return eol_t_offset <= val && val < eol_t_offset + nb_characters; }
     [[nodiscard]] auto active_or_single() const -> bool { return val < first_multitok_val; }
     [[nodiscard]] auto char_or_active() const -> bool { return val < single_offset; }
     [[nodiscard]] auto val_as_other() const -> size_t { return val - other_t_offset; }
@@ -71,4 +77,223 @@ struct Token {
 
 inline auto make_char_token(unsigned char c, unsigned cat) -> Token { return Token(nb_characters * cat + c); }
 
-using TokenList = std::list<Token>;
+// A list of tokens. The tokens are stored in a single array, with free room
+// at both ends, because tokens are added at the front (back_input) or at the
+// end, and removed from the front, much more often than elsewhere. The
+// interface is that of std::list<Token>, but iterators are plain pointers, and
+// they are invalidated by insertions and deletions.
+class TokenList {
+    std::vector<Token, PoolAllocator<Token>> buf;      // the storage
+    size_t                                   first{0}; // the tokens are buf[first, last)
+    size_t                                   last{0};
+
+    // Makes sure that there is room for a tokens before first and b tokens after last
+    void make_room(size_t a, size_t b) {
+        if (first >= a && buf.size() - last >= b) return;
+        auto n    = size();
+        auto need = n + a + b;
+        auto pos  = a + (a != 0 ? need / 2 : 0); // where the tokens go, leave room in front if needed
+        if (buf.size() >= 2 * need && pos + n + b <= buf.size()) {
+            std::memmove(buf.data() + pos, buf.data() + first, n * sizeof(Token));
+        } else {
+            decltype(buf) nbuf(std::max<size_t>(16, 2 * need));
+            pos = std::min(pos, nbuf.size() - n - b);
+            std::memcpy(nbuf.data() + pos, buf.data() + first, n * sizeof(Token));
+            buf.swap(nbuf);
+        }
+        first = pos;
+        last  = pos + n;
+    }
+
+    // Opens a gap of n tokens at position k (relative to first); returns the absolute position
+    auto open_gap(size_t k, size_t n) -> size_t {
+        auto sz = size();
+        if (k < sz - k) {
+            make_room(n, 0);
+            std::memmove(buf.data() + first - n, buf.data() + first, k * sizeof(Token));
+            first -= n;
+        } else {
+            make_room(0, n);
+            std::memmove(buf.data() + first + k + n, buf.data() + first + k, (sz - k) * sizeof(Token));
+            last += n;
+        }
+        return first + k;
+    }
+
+public:
+    using value_type             = Token;
+    using iterator               = Token *;
+    using const_iterator         = const Token *;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    TokenList() = default;
+    TokenList(std::initializer_list<Token> L) : buf(L), last(L.size()) {}
+    TokenList(const TokenList &L) : buf(L.begin(), L.end()), last(L.size()) {}
+    TokenList(TokenList &&L) noexcept : buf(std::move(L.buf)), first(L.first), last(L.last) { L.first = L.last = 0; }
+    template <typename It> TokenList(It a, It b) : buf(a, b), last(buf.size()) {}
+    ~TokenList() = default;
+
+    auto operator=(const TokenList &L) -> TokenList & {
+        if (this != &L) {
+            buf.assign(L.begin(), L.end());
+            first = 0;
+            last  = buf.size();
+        }
+        return *this;
+    }
+    auto operator=(TokenList &&L) noexcept -> TokenList & {
+        buf.swap(L.buf);
+        std::swap(first, L.first);
+        std::swap(last, L.last);
+        L.clear();
+        return *this;
+    }
+
+    [[nodiscard]] auto size() const -> size_t { return last - first; }
+    [[nodiscard]] auto empty() const -> bool { return first == last; }
+    [[nodiscard]] auto begin() -> iterator { return buf.data() + first; }
+    [[nodiscard]] auto end() -> iterator { return buf.data() + last; }
+    [[nodiscard]] auto begin() const -> const_iterator { return buf.data() + first; }
+    [[nodiscard]] auto end() const -> const_iterator { return buf.data() + last; }
+    [[nodiscard]] auto cbegin() const -> const_iterator { return begin(); }
+    [[nodiscard]] auto cend() const -> const_iterator { return end(); }
+    [[nodiscard]] auto rbegin() -> reverse_iterator { return reverse_iterator(end()); }
+    [[nodiscard]] auto rend() -> reverse_iterator { return reverse_iterator(begin()); }
+    [[nodiscard]] auto rbegin() const -> const_reverse_iterator { return const_reverse_iterator(end()); }
+    [[nodiscard]] auto rend() const -> const_reverse_iterator { return const_reverse_iterator(begin()); }
+    [[nodiscard]] auto front() -> Token & { return buf[first]; }
+    [[nodiscard]] auto back() -> Token & { return buf[last - 1]; }
+    [[nodiscard]] auto front() const -> const Token & { return buf[first]; }
+    [[nodiscard]] auto back() const -> const Token & { return buf[last - 1]; }
+
+    void clear() { first = last = 0; }
+    void swap(TokenList &L) noexcept {
+        buf.swap(L.buf);
+        std::swap(first, L.first);
+        std::swap(last, L.last);
+    }
+    void push_back(Token t) {
+        if (last == buf.size()) make_room(0, 1);
+        buf[last++] = t;
+    }
+    void push_front(Token t) {
+        if (first == 0) make_room(1, 0);
+        buf[--first] = t;
+    }
+    // Adds n unspecified tokens in front, and returns an iterator to them.
+    auto grow_front(size_t n) -> iterator {
+        make_room(n, 0);
+        first -= n;
+        return begin();
+    }
+    template <typename... Args> void emplace_back(Args &&... args) { push_back(Token(std::forward<Args>(args)...)); }
+    void pop_back() { --last; }
+    void pop_front() { ++first; }
+
+    auto insert(const_iterator p, Token t) -> iterator {
+        auto k = open_gap(static_cast<size_t>(p - begin()), 1);
+        buf[k] = t;
+        return buf.data() + k;
+    }
+    template <typename It> auto insert(const_iterator p, It a, It b) -> iterator {
+        auto n = static_cast<size_t>(std::distance(a, b));
+        auto k = open_gap(static_cast<size_t>(p - begin()), n);
+        std::copy(a, b, buf.data() + k);
+        return buf.data() + k;
+    }
+    auto erase(const_iterator a, const_iterator b) -> iterator {
+        auto i = static_cast<size_t>(a - begin()), j = static_cast<size_t>(b - begin());
+        if (i < size() - j) { // move the head
+            std::memmove(buf.data() + first + j - i, buf.data() + first, i * sizeof(Token));
+            first += j - i;
+            return buf.data() + first + i;
+        }
+        std::memmove(buf.data() + first + i, buf.data() + first + j, (size() - j) * sizeof(Token));
+        last -= j - i;
+        return buf.data() + first + i;
+    }
+    auto erase(const_iterator a) -> iterator { return erase(a, a + 1); }
+
+    // Moves the tokens of L here, before p; L becomes empty.
+    void splice(const_iterator p, TokenList &L) {
+        if (empty()) {
+            swap(L);
+            L.clear();
+            return;
+        }
+        if (L.empty()) return;
+        insert(p, L.begin(), L.end());
+        L.clear();
+    }
+    // Moves the tokens [a,b) of L here, before p.
+    void splice(const_iterator p, TokenList &L, const_iterator a, const_iterator b) {
+        insert(p, a, b);
+        L.erase(a, b);
+    }
+    template <typename P> void remove_if(P pred) { last = static_cast<size_t>(std::remove_if(begin(), end(), pred) - buf.data()); }
+
+    auto operator==(const TokenList &L) const -> bool {
+        return std::equal(begin(), end(), L.begin(), L.end(), [](Token a, Token b) { return a.val == b.val; });
+    }
+    auto operator!=(const TokenList &L) const -> bool { return !(*this == L); }
+};
+
+inline void swap(TokenList &A, TokenList &B) noexcept { A.swap(B); }
+
+// A read-only view on consecutive tokens, for instance the body of a macro.
+class TokenSpan {
+    const Token *b{nullptr}, *e{nullptr};
+
+public:
+    TokenSpan() = default;
+    TokenSpan(const Token *x, const Token *y) : b(x), e(y) {}
+    TokenSpan(const TokenList &L) : b(L.begin()), e(L.end()) {}
+
+    [[nodiscard]] auto begin() const -> const Token * { return b; }
+    [[nodiscard]] auto end() const -> const Token * { return e; }
+    [[nodiscard]] auto size() const -> size_t { return static_cast<size_t>(e - b); }
+    [[nodiscard]] auto empty() const -> bool { return b == e; }
+    [[nodiscard]] auto front() const -> Token { return *b; }
+    [[nodiscard]] auto to_list() const -> TokenList { return TokenList(b, e); }
+};
+
+// A token list that is never modified, so that it can be shared: a copy
+// only increments a reference count. This is used for the values of token
+// registers, on the save stack, and for the templates of tables; a list is
+// copied for real only when put in the input.
+class SharedTokenList {
+    struct Node {
+        TokenList list;
+        size_t    refs{1};
+
+        static auto operator new(size_t n) -> void * { return NodePool::get(n); }
+        static void operator delete(void *p, size_t n) noexcept { NodePool::put(p, n); }
+    };
+    static inline const TokenList empty_list{};
+    Node *                        node{nullptr}; // null for the empty list
+
+public:
+    SharedTokenList() = default;
+    SharedTokenList(TokenList &&L) : node(L.empty() ? nullptr : new Node{std::move(L)}) {}
+    SharedTokenList(const SharedTokenList &x) : node(x.node) {
+        if (node != nullptr) node->refs++;
+    }
+    SharedTokenList(SharedTokenList &&x) noexcept : node(x.node) { x.node = nullptr; }
+    ~SharedTokenList() {
+        if (node != nullptr && --node->refs == 0) delete node;
+    }
+    auto operator=(SharedTokenList x) noexcept -> SharedTokenList & {
+        std::swap(node, x.node);
+        return *this;
+    }
+
+    [[nodiscard]] auto get() const -> const TokenList & { return node != nullptr ? node->list : empty_list; }
+    operator const TokenList &() const { return get(); }
+    [[nodiscard]] auto begin() const -> TokenList::const_iterator { return get().begin(); }
+    [[nodiscard]] auto end() const -> TokenList::const_iterator { return get().end(); }
+    [[nodiscard]] auto size() const -> size_t { return get().size(); }
+    [[nodiscard]] auto empty() const -> bool { return node == nullptr; }
+
+    auto operator==(const SharedTokenList &L) const -> bool { return node == L.node || get() == L.get(); }
+};
@@ -260,6 +260,7 @@ enum symcodes {
     saveverb_cmd,
     makeatletter_cmd,
     makeatother_cmd,
+    catcode_table_cmd,
     add_to_macro_cmd,
     numberedverbatim_cmd,
     unnumberedverbatim_cmd,
@@ -527,6 +528,7 @@ enum subtypes {
     atmathversion_code,
     mathprop_ctr_code,
     use_subfigure_code,
+    catcodetable_code,
     textfont_code,
     scriptfont_code       = textfont_code + 16,
     scriptscriptfont_code = scriptfont_code + 16,
@@ -2813,7 +2815,7 @@ enum internal_type { it_int = 0, it_dimen, it_glue, it_mu, it_ident, it_tok };
 enum scan_expr_t { se_none, se_add, se_sub, se_mult, se_div, se_scale };
 
 // type of what is on the save stack, to be restored when we see a }.
-enum save_type { st_boundary, st_cmd, st_int, st_dim, st_glue, st_token, st_save, st_env, st_font, st_box, st_box_end, st_string };
+enum save_type { st_boundary, st_cmd, st_int, st_dim, st_glue, st_token, st_save, st_env, st_font, st_box, st_box_end, st_string, st_catcode };
 
 // math delimiters. used for \left[\right] or <mrow open=a close=b>
 enum del_pos {
@@ -79,7 +79,7 @@ auto Parser::nct_aux(Token T, TokenList &body) -> std::optional<size_t> {
     if (!cur_cmd_chr.is_user()) return {}; // bad
     Macro &X = mac_table.get_macro(cur_cmd_chr.chr);
     if (!(X.type == dt_empty || X.type == dt_normal)) return {};
-    body = X.body;
+    body = X.body().to_list();
     return X.nbargs;
 }
 
@@ -142,8 +142,7 @@ auto token_ns::expand_nct(TokenList &L, size_t n, uchar c, int &MX, TokenList &b
         MX--;
         if (MX < 0) return true;
         for (size_t k = 0; k < n; k++) Table[k + 1] = get_a_param(L, false);
-        TokenList W = Parser::expand_mac_inner(body, Table.data());
-        L.splice(L.begin(), W);
+        Parser::expand_mac_inner(body, Table.data(), L);
     }
     L.splice(L.end(), res);
     return result;
@@ -403,7 +402,7 @@ void NewArray::ac_maybe_finish() {
         return;
     }
     if (last_ch_class == chc_cell || last_ch_class == chc_v || last_ch_class == chc_bar) {
-        AI->add_uv(u_list, v_list, attribs);
+        AI->add_uv(std::move(u_list), std::move(v_list), attribs);
         attribs.reset();
         u_list.clear();
         v_list.clear();
@@ -534,7 +533,7 @@ void Parser::start_a_cell(bool started) {
         Xid cid = the_stack.get_top_id();
         new_array_object.run(cid, false);
     } else {
-        TokenList L = the_stack.get_u_or_v(true);
+        auto L = the_stack.get_u_or_v(true);
         if (tracing_commands() && !L.empty()) the_log << lg_startbrace << "template u-part " << L << lg_endbrace;
         back_input(L);
     }
@@ -551,7 +550,7 @@ void Parser::finish_a_cell(Token T, Istring a) {
     }
     back_input(T);
     if (the_stack.is_omit_cell()) return;
-    TokenList L = the_stack.get_u_or_v(false);
+    auto L = the_stack.get_u_or_v(false);
     if (tracing_commands() && !L.empty()) the_log << lg_startbrace << "template v-part " << L << lg_endbrace;
     back_input(L);
 }
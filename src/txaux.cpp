@@ -612,17 +612,34 @@ auto SpecialHash::find_counter() -> int {
 // finds a slot for the macro
 // Note: the reference count is 0. This is strange: the macro has to
 // be killed or its reference count increased.
-
+// If an identical macro exists, s is deleted and the old slot is returned,
+// with its reference count unchanged.
 auto Mactab::new_macro(Macro *s) -> subtypes {
+    auto range = interned.equal_range(s->hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        auto w = it->second;
+        if (!table[w]->is_identical(*s)) continue;
+        the_parser.my_stats.one_more_shared_macro();
+        delete_macro(s);
+        return subtypes(w);
+    }
     the_parser.my_stats.one_more_macro();
     if (ptr < 0) rc_mac_realloc();
     auto w      = ptr;
     ptr         = rc_table[w];
     rc_table[w] = 0;
     table[w]    = s;
+    interned.emplace(s->hash, w);
     return subtypes(w);
 }
 
+// Kills a macro, and gives back its tokens.
+void Mactab::delete_macro(Macro *X) {
+    tokens.give_back(X->toks, X->limit[10]);
+    failures.give_back(X->fail, X->limit[9]);
+    delete X;
+}
+
 // Initially cur_rc_mac_len=0, tables are empty
 // Note that the table always contains a valid pointer
 void Mactab::rc_mac_realloc() {
@@ -658,7 +675,13 @@ void Mactab::delete_macro_ref(int i) {
     rc_table[i]--;
     if (rc_table[i] == 0) {
         the_parser.my_stats.one_less_macro();
-        delete table[i];
+        auto range = interned.equal_range(table[i]->hash);
+        for (auto it = range.first; it != range.second; ++it)
+            if (it->second == i) {
+                interned.erase(it);
+                break;
+            }
+        delete_macro(table[i]);
         rc_table[i] = ptr;
         ptr         = i;
     }
@@ -510,6 +510,7 @@ void Parser::create_aux_file_and_run_pgm() {
     }
     the_log << "++ executing " << T.cmd << ".\n";
     system(T.cmd.c_str());
+    tralics_ns::forget_dir_index();
     B << bf_reset << tralics_ns::get_short_jobname() << ".bbl";
     // NOTE: can we use on-the-fly encoding ?
     the_log << "++ reading " << B.c_str() << ".\n";
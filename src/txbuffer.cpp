@@ -97,6 +97,14 @@ void Buffer::push_back(String s) {
     wptr += n;
 }
 
+// Inserts n bytes, that may contain null characters.
+void Buffer::push_back_bytes(String S, size_t n) {
+    alloc(n);
+    memcpy(data() + wptr, S, n);
+    wptr += n;
+    at(wptr) = 0;
+}
+
 void Buffer::push_back_substring(String S, size_t n) {
     alloc(n);
     strncpy(data() + wptr, S, n);
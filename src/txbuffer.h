@@ -14,6 +14,7 @@
 #include "txid.h"
 #include "txscaled.h"
 #include <cstring>
+#include <string_view>
 #include <vector>
 
 struct AttPair;
@@ -122,6 +123,7 @@ public:
     void               push_back(uchar c);
     void               push_back(const Buffer &b) { push_back(b.data()); }
     void               push_back(const std::string &b) { push_back(b.c_str()); }
+    void               push_back(std::string_view b) { push_back_bytes(b.data(), b.size()); }
     void               push_back(const Istring &X);
     void               push_back(String s);
     void               push_back(ScaledInt v, glue_spec unit);
@@ -132,13 +134,14 @@ public:
     void               push_back(const Macro &x);
     void               push_back(const Macro &x, bool sw);
     auto               push_back(Token T) -> bool;
-    void               push_back(const TokenList &L) {
+    void               push_back(TokenSpan L) {
         for (auto &C : L) { insert_token(C, false); }
     }
     void push_back(int n);
     void push_back(long n);
     void insert_token(Token T, bool sw);
     void push_back_alt(const AttPair &X);
+    void push_back_bytes(String S, size_t n);
     void push_back_braced(const std::string &s);
     void push_back_braced(String s);
     void push_back_def(String, std::string);
@@ -195,6 +195,68 @@ void Parser::translate_char(CmdChr X) {
     }
 }
 
+namespace {
+    // True if translate_char(c) is process_char(c), and process_char(c) needs
+    // no XML escape: printable characters less than 256, minus the quotes,
+    // dashes, French punctuation and XML specials.
+    auto is_plain_text_char(char32_t c) -> bool {
+        if (c < 32 || c >= 256) return false;
+        switch (c) {
+        case '-':
+        case '\'':
+        case '`':
+        case '<':
+        case '>':
+        case '&':
+        case '"':
+        case ';':
+        case ':':
+        case '!':
+        case '?':
+        case 0xBB:
+        case 0xAB: return false;
+        default: return true;
+        }
+    }
+} // namespace
+
+// Fast path of translate_all. The next tokens come from the input line;
+// the longest prefix made of plain characters of catcode letter or other
+// is put in unprocessed_xml at once, as translate_char would do it one
+// character at a time. Assumes horizontal mode and no tracing.
+void Parser::translate_char_run() {
+    auto n     = input_line.size();
+    auto k     = input_line_pos;
+    auto bytes = size_t(0);
+    for (; k < n; k++) {
+        auto c = input_line[k].value;
+        if (!is_plain_text_char(c)) break;
+        auto C = get_catcode(c);
+        if (C != letter_catcode && C != other_catcode) break;
+        bytes += c < 128 ? 1 : 2;
+    }
+    if (k == input_line_pos) return;
+    Buffer &B = unprocessed_xml;
+    B.alloc(bytes);
+    char *out = B.data() + B.wptr;
+    for (auto i = input_line_pos; i < k; i++) {
+        auto c = input_line[i].value;
+        if (c < 128)
+            *out++ = static_cast<char>(c);
+        else { // two bytes of UTF-8
+            *out++ = static_cast<char>(0xC0 + (c >> 6));
+            *out++ = static_cast<char>(0x80 + (c & 63));
+        }
+    }
+    B.wptr += bytes;
+    B.at(B.wptr) = 0;
+    auto last      = input_line[k - 1].value;
+    input_line_pos = k;
+    state          = state_M;
+    cur_cmd_chr    = CmdChr(get_catcode(last), subtypes(last));
+    cur_tok.from_cmd_chr(cur_cmd_chr);
+}
+
 // This translates `'<>
 // In some case ``, '', << and >> are translated as 0xAB and 0xBB
 void Parser::english_quotes(CmdChr X) {
@@ -785,8 +847,7 @@ void Parser::T_setmode() {
 // Translates \aftergroup\token
 void Parser::T_aftergroup() {
     get_token();
-    SaveAux *y = new SaveAuxAftergroup(cur_tok);
-    push_save_stack(y);
+    push_save_stack(SaveAux::aftergroup_entry(cur_tok));
 }
 
 // Translates \hskip1em, \vskip1em or \mskip3mu
@@ -1013,6 +1074,7 @@ void Parser::translate03() {
     case add_to_macro_cmd: T_addtomacro(c == 1); return;
     case makeatletter_cmd: word_define('@', letter_catcode, false); return;
     case makeatother_cmd: word_define('@', other_catcode, false); return;
+    case catcode_table_cmd: T_catcode_table(c); return;
     case numberedverbatim_cmd: numbered_verbatim = true; return;
     case unnumberedverbatim_cmd: numbered_verbatim = false; return;
     case after_assignment_cmd:
@@ -1264,11 +1326,7 @@ void Parser::translate03() {
     case unimp_cmd: T_unimp(c); return;
     case specimp_cmd: T_specimp(c); return;
     case thickness_cmd: T_linethickness(c); return;
-    case thm_aux_cmd: {
-        TokenList L = read_arg();
-        token_list_define(c, L, false);
-    }
-        return;
+    case thm_aux_cmd: token_list_define(c, read_arg(), false); return;
     case start_thm_cmd:
         if (c == 2)
             T_end_theorem();
@@ -16,10 +16,7 @@ class Parser;
 // Contains:
 //   equivalent, restore_vb_space, save_catcode, InLoadHandler,
 //  InUrlHandler, SaveState
-//   SaveAux, and derived types
-//     SaveAuxBoundary , SaveAuxInt , SaveAuxDim , SaveAuxCmd
-//     SaveAuxBox , SaveAuxBoxend, SaveAuxToken, SaveAuxGlue
-//     SaveAuxEnv , SaveAuxFont , SaveAuxAftergroup
+//   SaveAux, the entries of the save stack
 // the 5 types for eqtb:
 //   eqtb_int eqtb_dim eqtb_glue eqtb_token eqtb_box
 
@@ -129,166 +126,72 @@ public:
     void set_restricted(bool b) { restricted = b; }
 };
 
-// This is a virtual class for saving an object that is in an EQTB table
-// In general we have a level field, a position field and a value field
-// \todo this needs some overhaul...
+// An entry of the save stack. This is a tagged record, stored by value in
+// a vector, so that a local assignment allocates nothing; the type says
+// which member of the union is valid, and unsave switches on it.
+// In general we have a level field, a position field and a value field.
+// The strings of SaveAux::string and SaveAux::env are kept on a parallel
+// stack (an env record holds the index of its first string in pos).
 class SaveAux {
 public:
+    struct EnvVal {
+        Token  token; // the \endfoo token
+        CmdChr cc;    // its meaning at \begin{foo}
+        int    line;  // the line of the enclosing environment
+    };
+    struct FontVal {
+        long    value; // the packed font to be restored
+        Istring color; // the color to restore
+    };
+
     save_type type;    // the type of the real thing
     int       line{0}; // current line number at start
-public:
-    SaveAux(save_type t) : type(t) {}
-    virtual ~SaveAux() = default;
-
-    virtual void unsave(bool, Parser &) = 0;
-    void         set_line(int l) { line = l; }
-    void         unsave_trace_aux(String s, int pos, bool rt);
-    static void  restore_or_retain(bool rt, String s);
-};
-
-// A boundary object is created when we see an open brace, or something
-// like that.
-class SaveAuxBoundary : public SaveAux {
-public:
-    boundary_type val; // explains why we opened a new group
-
-    SaveAuxBoundary(boundary_type v) : SaveAux(st_boundary), val(v) {}
-    ~SaveAuxBoundary() override = default;
-
-    void unsave(bool trace, Parser &P) override;
-    void dump(int n);
-};
-
-// This restores an integer value.
-class SaveAuxInt : public SaveAux {
-    int    level; // the level that was active when this was pushed
-    size_t pos;   // the position in eqbt_int_table
-    long   val;   // the value to be restored
-public:
-    SaveAuxInt(int l, size_t a, long b) : SaveAux(st_int), level(l), pos(a), val(b) {}
-    ~SaveAuxInt() override = default;
-
-    void unsave(bool trace, Parser &P) override;
-};
+    int       level{}; // the level that was active when this was pushed
+    size_t    pos{};   // the position in the table to be restored
+    union {
+        boundary_type boundary{}; // st_boundary: why we opened a new group
+        long          int_val;    // st_int, st_catcode
+        ScaledInt     dim_val;    // st_dim
+        CmdChr        cmd_val;    // st_cmd
+        Xml *         box_val;    // st_box, st_box_end
+        Glue          glue_val;   // st_glue
+        Token         tok_val;    // st_save (\aftergroup)
+        EnvVal        env_val;    // st_env
+        FontVal       font_val;   // st_font
+    };
+    SharedTokenList toks_val; // st_token
 
-// This restores a dimension
-class SaveAuxDim : public SaveAux {
-    int       level; // the level that was active when this was pushed
-    size_t    pos;   // the position in eqbt_dim_table
-    ScaledInt val;   // the value to be restored
-public:
-    SaveAuxDim(int l, size_t a, ScaledInt b) : SaveAux(st_int), level(l), pos(a), val(b) {}
-    ~SaveAuxDim() override = default;
-
-    void unsave(bool trace, Parser &P) override;
-};
-
-// data structure for restoring a command
-class SaveAuxCmd : public SaveAux {
-    int    level; // the level that was active when this was pushed
-    size_t cs;    // ths position in eqtb to be restored
-    CmdChr val;   // the CmdChr to be restored
-public:
-    SaveAuxCmd(size_t a, const Equivalent &X) : SaveAux(st_cmd), level(X.level), cs(a), val(X) {}
-    ~SaveAuxCmd() override = default;
-
-    void unsave(bool trace, Parser &P) override;
-};
-
-// data structure fopr restoring a box
-class SaveAuxBox : public SaveAux {
-    int    level; // the level that was active when this was pushed
-    size_t pos;   // the position in box_table to be restored
-    Xml *  val;   // the value to be restored
-public:
-    SaveAuxBox(int l, size_t a, Xml *b) : SaveAux(st_box), level(l), pos(a), val(b) {}
-    ~SaveAuxBox() override = default;
-
-    void unsave(bool trace, Parser &P) override;
-};
-
-// case of \setbox0=\hbox{...} , remember the number and the box
-class SaveAuxBoxend : public SaveAux {
-    size_t pos; // the box number
-    Xml *  val; // the value of the box
-public:
-    SaveAuxBoxend(size_t a, Xml *b) : SaveAux(st_box_end), pos(a), val(b) {}
-    ~SaveAuxBoxend() override = default;
-
-    void unsave(bool trace, Parser &P) override;
-};
-
-// data structure for restoring a token list
-class SaveAuxToken : public SaveAux {
-    int       level; // the level that was active when this was pushed
-    size_t    pos;   // pthe position in toks_registers
-    TokenList val;   // the value to be restored
-public:
-    SaveAuxToken(int l, size_t p, TokenList v) : SaveAux(st_token), level(l), pos(p), val(std::move(v)) {}
-    ~SaveAuxToken() override = default;
-
-    void unsave(bool trace, Parser &P) override;
-};
-
-// data structure for restoring glue
-class SaveAuxGlue : public SaveAux {
-    int    level; // the level that was active when this was pushed
-    size_t pos;   // the position in glue_table
-    Glue   val;   // the value to be restored
-public:
-    SaveAuxGlue(int l, size_t p, Glue g) : SaveAux(st_glue), level(l), pos(p), val(g) {}
-    ~SaveAuxGlue() override = default;
-
-    void unsave(bool trace, Parser &P) override;
-};
-
-// data structure for restoring glue
-class SaveAuxString : public SaveAux {
-    int         level;
-    size_t      pos; // the position in glue_table
-    std::string val; // the value to be restored
-public:
-    SaveAuxString(int l, size_t p, std::string s) : SaveAux(st_string), level(l), pos(p), val(std::move(s)) {}
-    ~SaveAuxString() override = default;
-
-    void unsave(bool trace, Parser &P) override;
-};
-
-// data structure for a \begin{something}
-class SaveAuxEnv : public SaveAux {
-public:
-    std::string oldname;
-    std::string name;
-    int         line;
-    Token       token;
-    CmdChr      cc;
-
-    SaveAuxEnv(std::string a, std::string aa, int ll, Token b, CmdChr c)
-        : SaveAux(st_env), oldname(std::move(a)), name(std::move(aa)), line(ll), token(b), cc(c) {}
-    ~SaveAuxEnv() override = default;
-
-    void set_line(int x) { line = x; }
-    void unsave(bool trace, Parser &P) override;
-};
-
-// data structure for a font change
-class SaveAuxFont : public SaveAux {
-    int     level; // the level that was active when this was pushed
-    long    value; // the value to be restored
-    Istring color; // the color to restore
-public:
-    SaveAuxFont(int l, long v, Istring c) : SaveAux(st_font), level(l), value(v), color(c) {}
-    ~SaveAuxFont() override = default;
-
-    void unsave(bool trace, Parser &P) override;
-};
+    SaveAux(save_type t) : type(t) {}
 
-// This pops a token at the end of the group. Does not depend on a level
-class SaveAuxAftergroup : public SaveAux {
-    Token value; // the token to pop
-public:
-    SaveAuxAftergroup(Token v) : SaveAux(st_save), value(v) {}
-    ~SaveAuxAftergroup() override = default;
+    static auto boundary_entry(boundary_type v) -> SaveAux;
+    static auto int_entry(int l, size_t a, long b) -> SaveAux;
+    static auto catcode_entry(int l, size_t k, size_t c, long b) -> SaveAux;
+    static auto dim_entry(int l, size_t a, ScaledInt b) -> SaveAux;
+    static auto cmd_entry(size_t a, const Equivalent &X) -> SaveAux;
+    static auto box_entry(int l, size_t a, Xml *b) -> SaveAux;
+    static auto boxend_entry(size_t a, Xml *b) -> SaveAux;
+    static auto token_entry(int l, size_t p, SharedTokenList v) -> SaveAux;
+    static auto glue_entry(int l, size_t p, Glue g) -> SaveAux;
+    static auto string_entry(int l, size_t p) -> SaveAux;
+    static auto env_entry(size_t k, int ll, Token b, CmdChr c) -> SaveAux;
+    static auto font_entry(int l, long v, Istring c) -> SaveAux;
+    static auto aftergroup_entry(Token v) -> SaveAux;
+
+    void        unsave(bool trace, Parser &P);
+    void        dump(int n) const;
+    static void restore_or_retain(bool rt, String s);
 
-    void unsave(bool trace, Parser &P) override;
+private:
+    void unsave_boundary(bool trace, Parser &P) const;
+    void unsave_int(bool trace, Parser &P) const;
+    void unsave_dim(bool trace, Parser &P) const;
+    void unsave_cmd(bool trace, Parser &P) const;
+    void unsave_box(bool trace, Parser &P) const;
+    void unsave_boxend(bool trace, Parser &P) const;
+    void unsave_token(bool trace, Parser &P);
+    void unsave_glue(bool trace, Parser &P) const;
+    void unsave_string(bool trace, Parser &P) const;
+    void unsave_env(bool trace, Parser &P) const;
+    void unsave_font(bool trace, Parser &P) const;
+    void unsave_aftergroup(bool trace, Parser &P) const;
 };
@@ -1901,9 +1901,11 @@ auto FpGenList::split_at_p(TokenList &A, TokenList &B) -> bool {
     }
     // close paren seen
     if (p1 == E) return false;
-    A.splice(A.begin(), value, value.begin(), p1);
+    auto n1 = std::distance(value.begin(), p1);
+    auto n2 = std::distance(p1, p2) - 1;
+    A.splice(A.begin(), value, value.begin(), std::next(value.begin(), n1));
     value.pop_front(); // remove open parenn
-    B.splice(B.begin(), value, value.begin(), p2);
+    B.splice(B.begin(), value, value.begin(), std::next(value.begin(), n2));
     value.pop_front(); // remove close paren
     return true;
 }
@@ -1932,24 +1934,25 @@ void FpGenList::to_postfix() {
 // this  gives    (3+4)*(0-5-6),
 void FpGenList::fp_check_paren() {
     Token x0(other_t_offset, '(');
-    Token x1 = the_parser.hash_table.minus_token;
-    Token x2 = the_parser.hash_table.plus_token;
-    auto  X  = value.begin();
-    auto  E  = value.end();
+    Token     x1 = the_parser.hash_table.minus_token;
+    Token     x2 = the_parser.hash_table.plus_token;
+    auto      X  = value.begin();
+    auto      E  = value.end();
+    TokenList res;
     while (X != E) {
         Token x = *X;
+        res.push_back(x);
+        ++X;
         if (x == x0) {
-            auto Y = X;
-            ++Y;
-            if (Y == E) return;
-            Token y = *Y;
+            if (X == E) break;
+            Token y = *X;
             if (y.is_space_token() || y == x2)
-                value.erase(Y);
+                ++X;
             else if (y == x1)
-                value.insert(Y, the_parser.hash_table.zero_token);
+                res.push_back(the_parser.hash_table.zero_token);
         }
-        ++X;
     }
+    value.swap(res);
 }
 
 // Most functions have the form \FPfct\foo{arg}. This reads the \foo
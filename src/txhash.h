@@ -11,8 +11,12 @@
 // "http://www.cecill.info".
 // (See the file COPYING in the main directory for details)
 
-// This is the main hash table. If a token like \foo has hashcode p,
-// then foo is in Text[p], or in Text[Next[p]] or in Text[Next[Next[p]]] ...
+// This is the main hash table. A control sequence like \foo gets a location p
+// when first seen; foo is Text[p], the token is p+hash_offset, and eqtb has
+// an entry for it. Locations never change. Names are found via Index, an
+// open addressing table (linear probing, FNV-1a hash codes) that holds p+1,
+// and is rehashed when half full; eqtb grows with Text. Most primitives come
+// from a table whose Index image is computed at compile time.
 // The data structure holds the location of tokens like \par
 // that are known only after bootstrap
 class Hashtab {
@@ -62,17 +66,23 @@ public:
 
     std::array<Token, 15>             my_mathfont_table;
     std::array<Token, 5>              genfrac_mode;
-    std::array<Equivalent, eqtb_size> eqtb;
+    std::vector<Equivalent>           eqtb;
 
 private:
-    std::array<String, hash_size> Text{};    // the strings
-    std::array<size_t, hash_size> Next{};    // points to next
-    Buffer                        B;         // internal buffer
-    size_t                        hash_used; // all places above this one are used
+    std::vector<String>   Text;   // the strings
+    std::vector<size_t>   Hash;   // their hash codes
+    std::vector<uint32_t> Index;  // the open addressing table
+    size_t                mask{}; // size of Index minus one
+    Buffer                B;      // internal buffer
+
+    template <typename F> auto find_slot(size_t h, F same) const -> size_t;
+    auto                       new_location(String s, size_t h) -> size_t;
+    void                       rehash();
 
 public:
-    int hash_bad{}; // number of items not at hash position
-    int hash_usage; // number of commands in the table
+    int  hash_bad{};    // number of items not at hash position
+    int  hash_usage;    // number of commands in the table
+    bool l3_autoload{}; // are some modules of latex3 not yet loaded?
 
     Hashtab();
 
@@ -80,6 +90,7 @@ public:
     auto locate(String s) -> Token;             // used by primitive, etc
     auto locate(const std::string &s) -> Token; // used by primitive, etc
     auto locate(const Buffer &b) -> Token;      // used by primitive, etc
+    auto locate(const codepoint *s, size_t n, size_t h) -> Token;
     auto hash_find(const Buffer &b, String name) -> size_t;
     auto hash_find() -> size_t;
     auto primitive(String s, symcodes c, subtypes v = zero_code) -> Token;
@@ -87,13 +98,26 @@ public:
     void eval_let(String a, String b);
     auto eval_letv(String a, String b) -> Token;
     void eval_let_local(String a, String b);
-    auto find_empty(String s) -> size_t; // find an empty slot
-    auto find_aux(size_t p, String name) -> size_t;
+    static constexpr size_t boot_index_size = 1 << 13;                // initial size of Index
+    static constexpr size_t hash_seed       = 14695981039346656037ULL; // FNV-1a offset basis
+    static constexpr auto   hash_step(size_t h, size_t c) -> size_t { return (h ^ c) * 1099511628211ULL; }
+    static constexpr auto   hash_code(String s) -> size_t {
+        size_t h = hash_seed;
+        for (; *s != 0; s++) h = hash_step(h, static_cast<uchar>(*s));
+        return h;
+    }
     auto operator[](size_t k) const { return Text[k]; }
     void dump();
     void boot_fancyhdr();
     void boot_etex();
-    void load_latex3();
+    void load_latex3(bool preload);
+    void load_latex3_tex();
+    void load_latex3_str();
+    void load_latex3_char();
+    void load_latex3_token();
+    void load_latex3_tl();
+    void start_latex3_autoload(size_t n);
+    auto load_latex3_for(String s) -> bool;
     void boot_keyval();
     auto is_defined(const Buffer &b) -> bool;
 };
@@ -35,10 +35,13 @@ namespace tralics_ns {
     auto find_in_confdir(const std::string &s, bool retry) -> bool; ///< Try to open the file, using alt location if needed
     auto find_in_path(const std::string &s) -> bool;                ///< Tries to open a TeX file
     void read_a_file(LinePtr &L, const std::string &x, int spec);
+    void stream_a_file(LinePtr &L, const std::string &x);
     auto titlepage_is_valid() -> bool;
     auto file_exists(String name) -> bool;
     auto file_exists(const std::string &B) -> bool;
     auto file_exists(Buffer &B) -> bool;
+    auto file_exists(Buffer &B, const std::string &dir, const std::string &s) -> bool;
+    void forget_dir_index();
     void bibtex_boot(String b, String dy, std::string no_year, bool inra, bool db);
     void Titlepage_create(LinePtr &lines);
     void Titlepage_start(bool verbose);
@@ -14,7 +14,17 @@
 #include "tralics/globals.h"
 #include "txinline.h"
 #include "txparser.h"
+#include <dirent.h>
+#include <fcntl.h>
 #include <sstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <unordered_set>
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
 
 namespace {
     Buffer    thebuffer;
@@ -23,6 +33,109 @@ namespace {
     Buffer    utf8_in;             // Holds utf8 inbuffer
     Converter the_converter;
 
+    /// For each custom encoding, the number of ascii positions that are not
+    /// mapped to themselves; when zero, ascii runs need no table lookup.
+    std::array<int, max_encoding - 2> custom_ascii_changes{};
+
+    /// The names in each directory searched by find_in_confdir and
+    /// find_in_path; a directory is listed once, no value means that it
+    /// cannot be listed, or that its file system ignores case, so that a
+    /// name not in the list may exist. This is forgotten whenever we
+    /// create a file.
+    std::unordered_map<std::string, std::optional<std::unordered_set<std::string>>> dir_index;
+
+    /// True if some name of the directory, with the case of its letters
+    /// changed, is a valid file name, that is not in the directory.
+    auto ignores_case(const std::string &dir, const std::unordered_set<std::string> &names) -> bool {
+        for (const auto &n : names) {
+            std::string m = n;
+            for (auto &c : m) {
+                if (is_lower_case(c))
+                    c = static_cast<char>(c - 'a' + 'A');
+                else if (is_upper_case(c))
+                    c = static_cast<char>(to_lower(uchar(c)));
+            }
+            if (m == n) continue;
+            if (names.count(m) != 0) return false;
+            struct stat st {};
+            return stat((dir.empty() ? m : dir + "/" + m).c_str(), &st) == 0;
+        }
+        return false;
+    }
+
+    auto list_directory(const std::string &dir) -> std::optional<std::unordered_set<std::string>> {
+        DIR *d = opendir(dir.empty() ? "." : dir.c_str());
+        if (d == nullptr) return {};
+        std::unordered_set<std::string> res;
+        while (auto *e = readdir(d)) res.emplace(e->d_name);
+        closedir(d);
+        if (ignores_case(dir, res)) return {};
+        return res;
+    }
+
+    /// The bytes of a file, mapped in memory if possible, read otherwise.
+    /// An empty or unreadable file gives an empty image.
+    class FileImage {
+        char *            mapped{nullptr}; // result of mmap, if any
+        std::vector<char> copy;            // used when mmap fails
+        size_t            len{0};          // number of bytes
+
+    public:
+        explicit FileImage(const std::string &name);
+        ~FileImage() {
+            if (mapped != nullptr) munmap(mapped, len);
+        }
+        FileImage(const FileImage &) = delete;
+        auto operator=(const FileImage &) -> FileImage & = delete;
+
+        [[nodiscard]] auto data() const -> String { return mapped != nullptr ? mapped : copy.data(); }
+        [[nodiscard]] auto size() const -> size_t { return len; }
+        void               release(size_t a, size_t b) {
+            if (mapped != nullptr) madvise(mapped + a, b - a, MADV_DONTNEED);
+        }
+    };
+
+    FileImage::FileImage(const std::string &name) {
+        int fd = open(name.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return;
+        struct stat st {};
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+            len     = static_cast<size_t>(st.st_size);
+            void *m = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (m != MAP_FAILED) {
+                mapped = static_cast<char *>(m);
+                madvise(m, len, MADV_SEQUENTIAL);
+                close(fd);
+                return;
+            }
+        }
+        // Not a regular file, or mmap failed: read it by blocks
+        len = 0;
+        std::array<char, 65536> blk{};
+        for (;;) {
+            auto k = read(fd, blk.data(), blk.size());
+            if (k <= 0) break;
+            copy.insert(copy.end(), blk.data(), blk.data() + k);
+        }
+        len = copy.size();
+        close(fd);
+    }
+
+    /// Returns the position of the first CR or LF in [p,e), or e.
+    /// The positions of the next CR and next LF are cached in cr and lf
+    /// (null means unknown), so that the file is scanned by memchr at most twice.
+    auto next_eol(String p, String e, String &cr, String &lf) -> String {
+        if (cr == nullptr || (cr != e && cr < p)) {
+            auto *q = static_cast<String>(memchr(p, '\r', to_unsigned(e - p)));
+            cr      = q == nullptr ? e : q;
+        }
+        if (lf == nullptr || (lf != e && lf < p)) {
+            auto *q = static_cast<String>(memchr(p, '\n', to_unsigned(e - p)));
+            lf      = q == nullptr ? e : q;
+        }
+        return cr < lf ? cr : lf;
+    }
+
     /// Use a file from the pool
     auto use_pool(LinePtr &L) -> bool {
         if (!pool_position) return false; // should not happen
@@ -40,6 +153,8 @@ namespace io_ns {
     void set_enc_param(long enc, long pos, long v);
     auto get_enc_param(long enc, long pos) -> long;
     auto find_encoding(String cl) -> int;
+    auto ascii_prefix(String s, size_t n) -> size_t;
+    auto utf8_prefix(String s, size_t n) -> size_t;
 } // namespace io_ns
 
 // ---------------------------------------------------------
@@ -135,6 +250,11 @@ auto operator<<(HalfLogger &X, int s) -> HalfLogger & {
     X.L << s;
     return X;
 }
+auto operator<<(HalfLogger &X, size_t s) -> HalfLogger & {
+    if (X.verbose) std::cout << s;
+    X.L << s;
+    return X;
+}
 auto operator<<(HalfLogger &X, const std::string &s) -> HalfLogger & {
     if (X.verbose) std::cout << s;
     X.L << s;
@@ -351,17 +471,110 @@ auto Buffer::unique_character() const -> codepoint {
     return codepoint();
 }
 
+// Returns the number of leading bytes of s (of size n) that are ascii and
+// non-null, i.e. that every encoding leaves unchanged. Looks at 32 or 16
+// bytes at a time when the vector instructions are available.
+auto io_ns::ascii_prefix(String s, size_t n) -> size_t {
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i zero32 = _mm256_setzero_si256();
+    for (; i + 32 <= n; i += 32) {
+        __m256i v   = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i));
+        auto    bad = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_or_si256(v, _mm256_cmpeq_epi8(v, zero32))));
+        if (bad != 0) return i + static_cast<size_t>(__builtin_ctz(bad));
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= n; i += 16) {
+        __m128i v   = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+        auto    bad = static_cast<unsigned>(_mm_movemask_epi8(_mm_or_si128(v, _mm_cmpeq_epi8(v, zero))));
+        if (bad != 0) return i + static_cast<size_t>(__builtin_ctz(bad));
+    }
+#endif
+    for (; i < n; i++) {
+        auto c = static_cast<uchar>(s[i]);
+        if (c == 0 || c >= 128) break;
+    }
+    return i;
+}
+
+// Returns the number of leading bytes of s (of size n) that form valid UTF-8
+// characters that next_utf8_char would accept and push_back would encode
+// back to the same bytes: no null byte, no overlong form, nothing above
+// 1FFFF. Such a run can be copied as is. Ascii stretches are scanned by
+// ascii_prefix. A truncated character at the end is left to the caller.
+auto io_ns::utf8_prefix(String s, size_t n) -> size_t {
+    size_t i = 0;
+    while (i < n) {
+        auto c = static_cast<uchar>(s[i]);
+        if (c < 128) {
+            auto k = ascii_prefix(s + i, n - i);
+            if (k == 0) break;
+            i += k;
+            continue;
+        }
+        auto cont = [&](size_t j) { return i + j < n && (static_cast<uchar>(s[i + j]) >> 6) == 2; };
+        if (c >= 0xC2 && c < 0xE0) {
+            if (!cont(1)) break;
+            i += 2;
+        } else if (c >= 0xE0 && c < 0xF0) {
+            if (!cont(1) || !cont(2)) break;
+            if (c == 0xE0 && static_cast<uchar>(s[i + 1]) < 0xA0) break;
+            i += 3;
+        } else if (c == 0xF0) {
+            if (!cont(1) || !cont(2) || !cont(3)) break;
+            auto d = static_cast<uchar>(s[i + 1]);
+            if (d < 0x90 || d >= 0xA0) break;
+            i += 4;
+        } else
+            break;
+    }
+    return i;
+}
+
 // This converts a line in UTF8 format. Returns true if no conversion needed
 // Otherwise, the result is in utf8_out.
+// Runs of ascii characters are copied in one go; the common case of a line
+// that is all ascii returns before anything is copied. In UTF-8 mode, runs of
+// valid characters are copied as they are, and in latin1 mode runs of high
+// bytes are encoded directly; the general code is used for the rest, and
+// signals the errors.
 auto Buffer::convert_line0(size_t wc) -> bool {
+    bool ascii_ok = wc < 2 || custom_ascii_changes[wc - 2] == 0;
+    if (ascii_ok && io_ns::ascii_prefix(data(), wptr) == wptr) return the_converter.line_is_ascii;
     Buffer &res = utf8_out;
     res.reset();
     ptr = 0;
     codepoint c;
     for (;;) {
-        if (wc == 0)
+        if (ascii_ok) {
+            auto k = io_ns::ascii_prefix(data() + ptr, wptr - ptr);
+            res.push_back_bytes(data() + ptr, k);
+            ptr += k;
+            if (at_eol()) break;
+        }
+        if (wc == 0) {
+            auto k = io_ns::utf8_prefix(data() + ptr, wptr - ptr);
+            if (k != 0) {
+                the_converter.line_is_ascii = false;
+                res.push_back_bytes(data() + ptr, k);
+                ptr += k;
+                if (at_eol()) break;
+                continue;
+            }
             c = next_utf8_char();
-        else {
+        } else if (wc == 1 && static_cast<uchar>(at(ptr)) >= 128) {
+            the_converter.line_is_ascii = false;
+            for (; ptr < wptr; ptr++) {
+                auto C = static_cast<uchar>(at(ptr));
+                if (C < 128) break;
+                res.push_back(static_cast<char>(0xC0 | (C >> 6)));
+                res.push_back(static_cast<char>(0x80 | (C & 63)));
+            }
+            if (at_eol()) break;
+            continue;
+        } else {
             auto C = static_cast<uchar>(next_char());
             if (wc == 1)
                 c = codepoint(C);
@@ -385,15 +598,25 @@ void Buffer::convert_line(int l, size_t wc) {
     push_back(utf8_out.c_str());
 }
 
+// Replaces the characters of the line by c.
+void Clines::set_chars(std::string c) {
+    offset = 0;
+    length = c.size();
+    if (length == 0)
+        text.reset();
+    else
+        text = std::make_shared<const std::string>(std::move(c));
+}
+
 // This converts a line of a file
 void Clines::convert_line(size_t wc) {
     utf8_in.reset();
-    utf8_in.push_back(chars);
+    utf8_in.push_back(chars());
     converted = true;
     the_converter.start_convert(number);
     if (utf8_in.convert_line0(wc)) return;
     the_converter.lines_converted++;
-    chars = utf8_out.c_str();
+    set_chars(utf8_out.c_str());
 }
 
 // Why is v limited to 16bit chars?
@@ -409,10 +632,13 @@ void io_ns::set_enc_param(long enc, long pos, long v) {
         the_parser.parse_error(thebuffer.c_str());
         return;
     }
+    auto &slot = custom_table[to_unsigned(enc)][to_unsigned(pos)];
+    if (pos < 128 && slot != codepoint(to_unsigned(pos))) custom_ascii_changes[to_unsigned(enc)]--;
     if (0 < v && v < int(nb_characters))
-        custom_table[to_unsigned(enc)][to_unsigned(pos)] = codepoint(to_unsigned(v));
+        slot = codepoint(to_unsigned(v));
     else
-        custom_table[to_unsigned(enc)][to_unsigned(pos)] = codepoint(to_unsigned(pos));
+        slot = codepoint(to_unsigned(pos));
+    if (pos < 128 && slot != codepoint(to_unsigned(pos))) custom_ascii_changes[to_unsigned(enc)]++;
 }
 
 auto io_ns::get_enc_param(long enc, long pos) -> long {
@@ -478,103 +704,148 @@ auto LinePtr::read_from_tty(Buffer &B) -> int {
     return cur_line;
 }
 
-// inserts a copy of aux
+// inserts a copy of aux; the characters are shared, not copied.
 void LinePtr::insert(const LinePtr &aux) {
     encoding = 0;
-    auto C   = aux.begin();
-    auto E   = aux.end();
-    while (C != E) {
-        Clines L    = *C;
-        L.converted = false;
-        push_back(L);
-        ++C;
+    for (const auto &C : aux) {
+        push_back(C);
+        back().converted = false;
     }
 }
 
+// This holds a file being read, and splits it into lines (see read_a_file).
+// In streaming mode, the main file stays here, and LinePtr::get_next asks
+// for a window of lines when it needs one.
+class LineStream {
+    FileImage   F;
+    std::string name;      // the file name
+    int         spec;      // see read_a_file
+    size_t      wc;        // the encoding
+    int         co_try;    // number of lines that may contain the encoding
+    int         line{0};   // number of lines read so far
+    String      p, e;      // unread part of the file
+    String      cr{}, lf{}; // next CR and LF, see next_eol
+    size_t      released{0}; // pages before this offset have been released
+
+public:
+    LinePtr pending; // lines to insert after the end of the file
+
+    LineStream(const std::string &x, int s) : F(x), name(x), spec(s), wc(the_main->input_encoding), co_try(s == 3 ? 0 : 20) {
+        p = F.data();
+        e = p + F.size();
+    }
+    auto size() const -> size_t { return F.size(); }
+    auto read(LinePtr &L, size_t max) -> bool;
+};
+
+// Appends to L the lines that hold the next max bytes of the file
+// (at least one line); returns false at end of file.
+auto LineStream::read(LinePtr &L, size_t max) -> bool {
+    if (p >= e) return false;
+    std::string old_name        = the_converter.cur_file_name;
+    the_converter.cur_file_name = name;
+    Buffer B;
+    bool   converted = spec < 2;
+    String stop      = p + std::min(max, to_unsigned(e - p));
+    auto   image     = std::make_shared<std::string>();
+    image->reserve(to_unsigned(stop - p) + to_unsigned(stop - p) / 32 + 1);
+    L.cur_line = line;
+    while (p < stop || (p < e && image->empty())) {
+        String q = next_eol(p, e, cr, lf);
+        B.push_back_bytes(p, to_unsigned(q - p));
+        p = q;
+        if (p < e) {
+            if (*p == '\r' && p + 1 < e && p[1] == '\n') ++p;
+            ++p;
+        }
+        bool emit = true;
+        if (spec == 0) // special case of config file
+            emit = B.push_back_newline_spec();
+        else
+            B.push_back_newline();
+        if (co_try != 0) {
+            co_try--;
+            int k = io_ns::find_encoding(B.c_str());
+            if (k >= 0) {
+                wc = to_unsigned(k);
+                L.set_encoding(wc);
+                co_try = 0;
+                the_log << lg_start_io << "Input encoding number " << k << " detected  at line " << L.cur_line + 1 << " of file " << name
+                        << lg_end;
+            }
+        }
+        if (converted) B.convert_line(L.cur_line + 1, wc);
+        if (emit)
+            L.insert(image, B, converted);
+        else
+            L.incr_cur_line();
+        B.reset();
+    }
+    image->shrink_to_fit();
+    line                        = L.cur_line;
+    the_converter.cur_file_name = old_name;
+    if (p < e) { // the part of the file we have read will not be used again
+        auto page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        auto done = to_unsigned(p - F.data()) / page * page;
+        if (done > released) F.release(released, done);
+        released = done;
+    }
+    return true;
+}
+
 // This reads the file named x.
 // If spec is 0, we are reading the config file.
 // If 2 it's a tex file, and the file is converted later.
 // If 3, no conversion  done
 // If 4, its is the main file, log not yet open.
+// The file is mapped in memory, and lines are found by memchr; a line ends
+// with LF, CR, or CR-LF, and the last line may have no end marker.
+// All lines are stored in a single string shared by the lines of L.
 void tralics_ns::read_a_file(LinePtr &L, const std::string &x, int spec) {
     L.reset(x);
     if (use_pool(L)) return;
-    auto *fp = new std::fstream(x.c_str(), std::ios::in);
-    if (fp == nullptr) return;
-    std::string old_name        = the_converter.cur_file_name;
-    the_converter.cur_file_name = x;
-    Buffer B;
-    auto   wc        = the_main->input_encoding;
-    bool   converted = spec < 2;
+    LineStream S(x, spec);
     L.set_encoding(the_main->input_encoding);
-    int co_try = spec == 3 ? 0 : 20;
-    for (;;) {
-        int  c    = fp->get();
-        bool emit = false;
-        if (c == '\r') { // pc or mac ?
-            emit = true;
-            c    = fp->peek();
-            if (c == '\n') fp->ignore();
-        } else if (c == '\n')
-            emit = true;
-        else if (c == EOF) {
-            if (!B.empty()) emit = true;
-            fp->close();
-            delete fp;
-            the_converter.cur_file_name = old_name;
-        } else
-            B.push_back(static_cast<char>(c));
-        if (emit) {
-            if (spec == 0) // special case of config file
-                emit = B.push_back_newline_spec();
-            else
-                B.push_back_newline();
-            if (co_try != 0) {
-                co_try--;
-                int k = io_ns::find_encoding(B.c_str());
-                if (k >= 0) {
-                    wc = to_unsigned(k);
-                    L.set_encoding(wc);
-                    co_try = 0;
-                    the_log << lg_start_io << "Input encoding number " << k << " detected  at line " << L.cur_line + 1 << " of file " << x
-                            << lg_end;
-                }
-            }
-            if (converted) B.convert_line(L.cur_line + 1, wc);
-            if (emit)
-                L.insert(B.to_string(), converted);
-            else
-                L.incr_cur_line();
-            B.reset();
-        }
-        if (c == EOF) break;
-    }
+    S.read(L, S.size());
+}
+
+// Streaming variant of read_a_file(L, x, 4): only a first window of lines
+// is read; the prescans of the main file see only this part.
+void tralics_ns::stream_a_file(LinePtr &L, const std::string &x) {
+    L.reset(x);
+    if (use_pool(L)) return;
+    L.stream = std::make_shared<LineStream>(x, 4);
+    L.set_encoding(the_main->input_encoding);
+    L.stream->read(L, stream_prefix);
+}
+
+// Reads the next window of lines in streaming mode. At end of file,
+// the pending lines are added, and the stream is closed.
+auto LinePtr::refill() -> bool {
+    if (!stream) return false;
+    if (stream->read(*this, stream_window)) return true;
+    auto S = std::move(stream);
+    splice_end(S->pending);
+    return !empty();
 }
 
 // If a line ends with \, we take the next line, and append it to this one
 void LinePtr::normalise_final_cr() {
-    auto C = begin();
-    auto E = end();
-    if (C == E) return;
     Clines *prev = nullptr;
-    Clines *cur  = nullptr;
-    for (;;) {
-        if (C == E) return;
-        cur = &*C;
-        ++C;
-        const std::string &s       = cur->chars;
-        auto               n       = s.size();
-        bool               special = (n >= 2 && s[n - 2] == '\\' && s[n - 1] == '\n');
-        std::string        normal  = s;
-        if (special) normal = std::string(s, 0, n - 2);
+    for (auto &cur : *this) {
+        std::string_view s       = cur.chars();
+        auto             n       = s.size();
+        bool             special = (n >= 2 && s[n - 2] == '\\' && s[n - 1] == '\n');
+        std::string_view normal  = s;
+        if (special) normal = s.substr(0, n - 2);
         if (prev != nullptr) {
-            prev->chars = prev->chars + normal;
-            cur->chars  = "\n";
+            prev->set_chars(std::string(prev->chars()) + std::string(normal));
+            cur.set_chars("\n");
         }
         if (special) {
             if (prev == nullptr) {
-                prev        = cur;
-                prev->chars = normal;
+                prev = &cur;
+                prev->set_chars(std::string(normal));
             }
         } else
             prev = nullptr;
@@ -901,10 +1172,30 @@ auto tralics_ns::file_exists(String name) -> bool {
 
 auto tralics_ns::file_exists(const std::string &B) -> bool { return tralics_ns::file_exists(B.c_str()); }
 
+// Same as file_exists(B), where B is dir/s; but the file system is not
+// queried when the index of dir says that it has no file s. Names with
+// non-ascii characters are not checked, because the file system may
+// normalise them.
+auto tralics_ns::file_exists(Buffer &B, const std::string &dir, const std::string &s) -> bool {
+    if (s.find('/') == std::string::npos && io_ns::ascii_prefix(s.data(), s.size()) == s.size()) {
+        auto it = dir_index.find(dir);
+        if (it == dir_index.end()) it = dir_index.emplace(dir, list_directory(dir)).first;
+        if (it->second && it->second->count(s) == 0) {
+            if (log_is_open) the_log << lg_start_io << "file " << B.c_str() << " does not exist" << lg_endsentence;
+            return false;
+        }
+    }
+    return tralics_ns::file_exists(B);
+}
+
+// This must be called when a file may have been created.
+void tralics_ns::forget_dir_index() { dir_index.clear(); }
+
 auto tralics_ns::file_exists(Buffer &B) -> bool { return tralics_ns::file_exists(B.c_str()); }
 
 // This exits if the file cannot be opened and argument is true
 auto tralics_ns::open_file(String name, bool fatal) -> std::fstream * {
+    forget_dir_index();
     auto *fp = new std::fstream(name, std::ios::out);
     if (log_is_open && !*fp) the_log << "Cannot open file " << name << " for output \n";
     if (fatal && !*fp) {
@@ -937,6 +1228,15 @@ void LinePtr::insert(int n, const std::string &c, bool cv) { emplace_back(n, c,
 // Insert a line at the end of the file, incrementing the line no
 void LinePtr::insert(const std::string &c, bool cv) { emplace_back(++cur_line, c, cv); }
 
+// Insert a line at the end of the file, incrementing the line no.
+// The characters are appended to T, and the line refers to them.
+void LinePtr::insert(const std::shared_ptr<std::string> &T, const Buffer &B, bool cv) {
+    auto o = T->size();
+    auto n = strlen(B.c_str());
+    T->append(B.c_str(), n);
+    emplace_back(++cur_line, T, o, n, cv);
+}
+
 // Insert a line at the end of the file, incrementing the line no
 // We assume that the const char* is ascii 7 bits
 void LinePtr::insert(String c) { emplace_back(++cur_line, c, true); }
@@ -944,7 +1244,10 @@ void LinePtr::insert(String c) { emplace_back(++cur_line, c, true); }
 // Like insert, but we do not insert an empty line after an empty line.
 // Used by the raweb preprocessor, hence already converted
 void LinePtr::insert_spec(int n, std::string c) {
-    if (!empty() && back().chars[0] == '\n' && c[0] == '\n') return;
+    if (!empty() && !c.empty() && c[0] == '\n') {
+        std::string_view last = back().chars();
+        if (!last.empty() && last[0] == '\n') return;
+    }
     insert(n, c, true);
 }
 
@@ -954,16 +1257,30 @@ void LinePtr::add(int n, Buffer &b, bool cv) {
     insert(n, b.to_string(), cv);
 }
 
+// Moves the lines of X before C; X becomes empty
+// In streaming mode, the end of the list is not the end of the file,
+// and lines inserted at the end are kept until the file is exhausted.
+void LinePtr::splice_at(line_iterator C, LinePtr &X) {
+    if (stream && C == end()) {
+        stream->pending.splice_end(X);
+        return;
+    }
+    std::deque<Clines>::insert(C, std::make_move_iterator(X.begin()), std::make_move_iterator(X.end()));
+    X.clear();
+}
+
 // insert a file at the start
-void LinePtr::splice_first(LinePtr &X) { splice(begin(), X); }
+void LinePtr::splice_first(LinePtr &X) { splice_at(begin(), X); }
 
 // insert at the end
-void LinePtr::splice_end(LinePtr &X) { splice(end(), X); }
+void LinePtr::splice_end(LinePtr &X) { splice_at(end(), X); }
 
-// Copy X here,
+// Copy X here, X becomes empty
 void LinePtr::clear_and_copy(LinePtr &X) {
-    clear();
-    splice(begin(), X);
+    std::deque<Clines>::operator=(std::move(X));
+    stream   = std::move(X.stream);
+    cur_line = X.cur_line;
+    X.clear();
     encoding = X.encoding;
     set_file_name(X.file_name);
 }
@@ -1010,7 +1327,7 @@ auto LinePtr::get_next(Buffer &b) -> int {
         n = read_from_tty(b);
         if (n == -1) interactive = false;
     } else {
-        if (empty()) return -1;
+        if (empty() && !refill()) return -1;
         n = front().to_buffer(b, converted);
         pop_front();
     }
@@ -1044,7 +1361,7 @@ auto LinePtr::get_next_raw(Buffer &b) -> int {
 
 // Puts the line in the string, instead of the buffer.
 auto LinePtr::get_next(std::string &b, bool &cv) -> int {
-    if (empty()) return -1;
+    if (empty() && !refill()) return -1;
     int n = front().to_string(b, cv);
     pop_front();
     return n;
@@ -1058,7 +1375,7 @@ auto LinePtr::find_documentclass(Buffer &B) -> std::string {
     the_main->doc_class_pos = E;
     while (C != E) {
         B.reset();
-        B.push_back(C->chars);
+        B.push_back(C->chars());
         Buffer &aux = thebuffer;
         bool    s   = B.find_documentclass(aux);
         if (s) {
@@ -1078,7 +1395,7 @@ void LinePtr::add_buffer(Buffer &B, line_iterator C) {
     if (C == end())
         push_front(Clines(1, B.to_string(), true));
     else
-        std::list<Clines>::insert(C, Clines(1, B.to_string(), true)); // \todo ew
+        std::deque<Clines>::insert(C, Clines(1, B.to_string(), true)); // \todo ew
 }
 
 // This finds a line with documentclass in it
@@ -1089,7 +1406,7 @@ auto LinePtr::find_configuration(Buffer &B) -> std::string {
     auto E = end();
     while (C != E) {
         B.reset();
-        B.push_back(C->chars);
+        B.push_back(C->chars());
         Buffer &aux = thebuffer;
         bool    s   = B.find_configuration(aux);
         if (s) return aux.to_string();
@@ -1108,7 +1425,7 @@ void LinePtr::find_doctype(Buffer &B, std::string &res) {
     auto E = end();
     while (C != E) {
         B.reset();
-        B.push_back(C->chars);
+        B.push_back(C->chars());
         auto k = B.find_doctype();
         if (k != 0) {
             res = B.to_string(k);
@@ -1127,6 +1444,7 @@ void LinePtr::split_string(String x, int l) {
     Buffer &B = thebuffer;
     LinePtr L;
     L.set_cur_line(l);
+    auto image = std::make_shared<std::string>();
     int i = 0;
     B.reset();
     for (;;) {
@@ -1141,7 +1459,7 @@ void LinePtr::split_string(String x, int l) {
             B.push_back(c);
         if (emit) {
             B.push_back_newline();
-            L.insert(B.to_string(), true);
+            L.insert(image, B, true);
             B.reset();
         }
         if (c == 0) break;
@@ -1153,7 +1471,7 @@ void LinePtr::print(std::fstream *outfile) {
     auto C = begin();
     auto E = end();
     while (C != E) {
-        *outfile << C->chars;
+        *outfile << C->chars();
         ++C;
     }
 }
@@ -1163,7 +1481,7 @@ void LinePtr::print() {
     auto C = begin();
     auto E = end();
     while (C != E) {
-        std::cout << C->number << "  " << C->chars;
+        std::cout << C->number << "  " << C->chars();
         ++C;
     }
 }
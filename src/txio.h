@@ -10,7 +10,10 @@
 // (See the file COPYING in the main directory for details)
 
 #include "txbuffer.h"
+#include <deque>
 #include <fstream>
+#include <memory>
+#include <string_view>
 
 void readline(char *buffer, size_t screen_size); ///< Read a line from standart input (readline.cpp)
 
@@ -35,21 +38,33 @@ public:
     void start_convert(int l);
 };
 
-// Whenever Tralics reads a file, it puts the result in a structure like this
-struct Clines {            // \todo rename to Line or something
-    int         number;    // the number of the current line
-    std::string chars;     // the characters on the line
-    bool        converted; // true if line is already converted
-
-    Clines(int n, std::string c = "", bool C = true) : number(n), chars(std::move(c)), converted(C) {}
-
+// Whenever Tralics reads a file, it puts the result in a structure like this.
+// The characters are not owned by the line, they are a slice of a shared
+// text (the image of the whole file when it comes from read_a_file), so that
+// copying a line, or a list of lines, copies no characters.
+struct Clines {                                  // \todo rename to Line or something
+    std::shared_ptr<const std::string> text;      // the storage, may be shared
+    size_t                             offset{0}; // start of the line in text
+    size_t                             length{0}; // number of characters
+    int                                number;    // the number of the current line
+    bool                               converted; // true if line is already converted
+
+    Clines(int n, std::string c = "", bool C = true) : number(n), converted(C) { set_chars(std::move(c)); }
+    Clines(int n, std::shared_ptr<const std::string> T, size_t o, size_t l, bool C)
+        : text(std::move(T)), offset(o), length(l), number(n), converted(C) {}
+
+    [[nodiscard]] auto chars() const -> std::string_view {
+        if (length == 0) return {};
+        return {text->data() + offset, length};
+    }
+    void set_chars(std::string c);
     auto to_string(std::string &C, bool &cv) const -> int {
-        C  = chars;
+        C  = chars();
         cv = converted;
         return number;
     }
     auto to_buffer(Buffer &b, bool &C) const -> int {
-        b.push_back(chars);
+        b.push_back(chars());
         C = converted;
         return number;
     }
@@ -58,14 +73,22 @@ struct Clines {            // \todo rename to Line or something
     void clear_converted() { converted = false; }
 };
 
-using line_iterator_const = std::list<Clines>::const_iterator;
-using line_iterator       = std::list<Clines>::iterator;
+using line_iterator_const = std::deque<Clines>::const_iterator;
+using line_iterator       = std::deque<Clines>::iterator;
 
-struct LinePtr : public std::list<Clines> { // \todo rename to LineList or something
-    int         cur_line{0};                // current line number
-    bool        interactive{false};         // is this file or a tty ? \todo get rid of interactive mode
-    std::string file_name;                  // file name associated to the lines
-    size_t      encoding{1};                // current file encoding
+class LineStream;
+
+// In streaming mode, the main file is read by windows of this many bytes;
+// the first window, the only part seen by the prescans, has stream_prefix bytes.
+inline constexpr size_t stream_window = 1 << 20;
+inline constexpr size_t stream_prefix = 1 << 16;
+
+struct LinePtr : public std::deque<Clines> { // \todo rename to LineList or something
+    int                         cur_line{0};        // current line number
+    bool                        interactive{false}; // is this file or a tty ? \todo get rid of interactive mode
+    std::string                 file_name;          // file name associated to the lines
+    size_t                      encoding{1};        // current file encoding
+    std::shared_ptr<LineStream> stream;             // in streaming mode, the rest of the file
 
     [[nodiscard]] auto dump_name() const -> String;
 
@@ -73,6 +96,10 @@ struct LinePtr : public std::list<Clines> { // \todo rename to LineList or somet
     void add_buffer(Buffer &B, line_iterator C);
     void after_open();
     void before_close(bool sigforce);
+    void clear() {
+        std::deque<Clines>::clear();
+        stream.reset();
+    }
     void clear_and_copy(LinePtr &X);
     void change_encoding(long wc);
     void find_tex_encoding();
@@ -92,6 +119,7 @@ struct LinePtr : public std::list<Clines> { // \todo rename to LineList or somet
     void incr_cur_line() { cur_line++; }
     void insert(int n, const std::string &c, bool cv); // \todo is emplace_back
     void insert(const std::string &c, bool cv);
+    void insert(const std::shared_ptr<std::string> &T, const Buffer &B, bool cv);
     void insert(String c);
     void insert_spec(int n, std::string c);
     void insert(const LinePtr &aux);
@@ -102,6 +130,7 @@ struct LinePtr : public std::list<Clines> { // \todo rename to LineList or somet
     void print();
     void print(std::fstream *outfile);
     void print1(std::fstream *);
+    auto refill() -> bool;
     void reset(std::string x);
     auto read_from_tty(Buffer &b) -> int;
     void set_cur_line(int x) { cur_line = x; }
@@ -109,6 +138,7 @@ struct LinePtr : public std::list<Clines> { // \todo rename to LineList or somet
     void set_file_name(std::string s) { file_name = std::move(s); }
     void set_interactive();
     auto skip_env(line_iterator_const C, Buffer &B) -> line_iterator_const;
+    void splice_at(line_iterator C, LinePtr &X);
     void splice_end(LinePtr &X);   // \todo inline
     void splice_first(LinePtr &X); // \todo inline
     void split_string(String x, int l);
@@ -175,7 +205,7 @@ class TexOutStream {
 public:
     TexOutStream();
     void               close(size_t chan);
-    void               open(size_t chan, const std::string &file_name);
+    void               open(size_t chan, const std::string &name);
     [[nodiscard]] auto is_open(size_t i) const -> bool { return write_open[i]; }
     void               write(size_t chan, const std::string &s) { *(write_file[chan]) << s; }
 };
@@ -99,11 +99,11 @@ auto Buffer::svn_id(std::string &name, std::string &date, std::string &version)
 // In latex3, a space is ignored, so locally redefine the catcode
 void Parser::L3_getid() {
     get_token(); // should be a dollar sign, but hack!
-    auto spcat                     = eqtb_int_table[uchar(' ')].val;
-    eqtb_int_table[uchar(' ')].val = 10;
-    TokenList l                    = read_until(cur_tok);
-    TokenList info                 = read_arg();
-    eqtb_int_table[uchar(' ')].val = spcat;
+    auto spcat               = catcodes[uchar(' ')].val;
+    catcodes[uchar(' ')].val = 10;
+    TokenList l              = read_until(cur_tok);
+    TokenList info           = read_arg();
+    catcodes[uchar(' ')].val = spcat;
     read_toks_edef(l);
     Buffer &B = local_buffer;
     B.reset();
@@ -675,8 +675,7 @@ void Parser::tl_set_rescan(int c) {
     push_level(bt_brace);
     word_define(endlinechar_code, -1, false);
     word_define(newlinechar_code, -1, false);
-    TokenList eof;
-    token_list_define(everyeof_code, eof, false);
+    token_list_define(everyeof_code, {}, false);
     flush_buffer();
     T_translate(side_effects);
     back_input(hash_table.CB_token);
@@ -796,7 +795,7 @@ void Parser::L3_set_num_code(int c) {
         signal_ovf(T, "Bad character code replaced by 0\n", m, scan_char_num_max);
         m = 0;
     }
-    auto v = eqtb_int_table[to_unsigned(m + offset)].val;
+    auto v = offset == cat_code_offset ? catcodes[m].val : eqtb_int_table[to_unsigned(m + offset)].val;
     if (show)
         log_and_tty << T << "{" << m << "}=" << v << "\n";
     else {
@@ -1590,7 +1589,7 @@ void Parser::L3_load(bool preload) {
     //  double_at_list.push_back(Token(letter_t_offset,'@'));
     //  double_at_no_list = double_at_list;
     //  double_at_no_list.push_back(hash_table.locate("noexpand"));
-    hash_table.load_latex3();
+    hash_table.load_latex3(preload);
     shorthand_gdefine(char_def_code, "c_sixteen", 16);
     Tc_zero = shorthand_gdefine(char_def_code, "c_zero", 0);
     shorthand_gdefine(char_def_code, "c_six", 6);
@@ -1643,8 +1642,6 @@ void Parser::L3_load(bool preload) {
     L.insert(R"(\edef\tmp{\catcode58=\the\catcode58 )");
     L.insert(R"(  \catcode95=\the\catcode95 \let\noexpand\tmp\relax})");
     L.insert("\\catcode58=11 \\catcode95=11 ");
-    L.insert(R"(\def\token_to_str:c{\exp_args:Nc\token_to_str:N})");
-    L.insert(R"(\def\token_new:Nn#1#2{\cs_new_eq:NN #1#2})");
     L.insert(R"(\def\c_catcode_active_tl{\noexpand~})");
     L.insert("\\tmp\\wlog{Loading latex3 (done)}");
     if (!preload) {
@@ -1656,458 +1653,497 @@ void Parser::L3_load(bool preload) {
     if (preload) translate0();
 }
 
-void Hashtab::load_latex3() {
-    // renaming everything
-    eval_let("tex_space:D", " ");
-    eval_let("tex_italiccorrection:D", "/");
-    eval_let("tex_hyphen:D", "-");
-    eval_let("tex_let:D", "let");
-    eval_let("tex_def:D", "def");
-    eval_let("tex_edef:D", "edef");
-    eval_let("tex_gdef:D", "gdef");
-    eval_let("tex_xdef:D", "xdef");
-    eval_let("tex_chardef:D", "chardef");
-    eval_let("tex_countdef:D", "countdef");
-    eval_let("tex_dimendef:D", "dimendef");
-    eval_let("tex_skipdef:D", "skipdef");
-    eval_let("tex_muskipdef:D", "muskipdef");
-    eval_let("tex_mathchardef:D", "mathchardef");
-    eval_let("tex_toksdef:D", "toksdef");
-    eval_let("tex_futurelet:D", "futurelet");
-    eval_let("tex_advance:D", "advance");
-    eval_let("tex_divide:D", "divide");
-    eval_let("tex_multiply:D", "multiply");
-    eval_let("tex_font:D", "font");
-    eval_let("tex_fam:D", "fam");
-    eval_let("tex_global:D", "global");
-    eval_let("tex_long:D", "long");
-    eval_let("tex_outer:D", "outer");
-    eval_let("tex_setlanguage:D", "setlanguage");
-    eval_let("tex_setlanguage:D", "setlanguage");
-    eval_let("tex_globaldefs:D", "globaldefs");
-    eval_let("tex_afterassignment:D", "afterassignment");
-    eval_let("tex_aftergroup:D", "aftergroup");
-    eval_let("tex_expandafter:D", "expandafter");
-    eval_let("tex_noexpand:D", "noexpand");
-    eval_let("tex_begingroup:D", "begingroup");
-    eval_let("tex_endgroup:D", "endgroup");
-    eval_let("tex_halign:D", "halign");
-    eval_let("tex_valign:D", "valign");
-    eval_let("tex_cr:D", "cr");
-    eval_let("tex_crcr:D", "crcr");
-    eval_let("tex_noalign:D", "noalign");
-    eval_let("tex_omit:D", "omit");
-    eval_let("tex_span:D", "span");
-    eval_let("tex_tabskip:D", "tabskip");
-    eval_let("tex_everycr:D", "everycr");
-    eval_let("tex_if:D", "if");
-    eval_let("tex_ifcase:D", "ifcase");
-    eval_let("tex_ifcat:D", "ifcat");
-    eval_let("tex_ifnum:D", "ifnum");
-    eval_let("tex_ifodd:D", "ifodd");
-    eval_let("tex_ifdim:D", "ifdim");
-    eval_let("tex_ifeof:D", "ifeof");
-    eval_let("tex_ifhbox:D", "ifhbox");
-    eval_let("tex_ifvbox:D", "ifvbox");
-    eval_let("tex_ifvoid:D", "ifvoid");
-    eval_let("tex_ifx:D", "ifx");
-    eval_let("tex_iffalse:D", "iffalse");
-    eval_let("tex_iftrue:D", "iftrue");
-    eval_let("tex_ifhmode:D", "ifhmode");
-    eval_let("tex_ifmmode:D", "ifmmode");
-    eval_let("tex_ifvmode:D", "ifvmode");
-    eval_let("tex_ifinner:D", "ifinner");
-    eval_let("tex_fi:D", "fi");
-    eval_let("tex_else:D", "else");
-    eval_let("tex_or:D", "or");
-    eval_let("tex_immediate:D", "immediate");
-    eval_let("tex_closeout:D", "closeout");
-    eval_let("tex_openin:D", "openin");
-    eval_let("tex_openout:D", "openout");
-    eval_let("tex_read:D", "read");
-    eval_let("tex_write:D", "write");
-    eval_let("tex_closein:D", "closein");
-    eval_let("tex_newlinechar:D", "newlinechar");
-    eval_let("tex_input:D", "input");
-    eval_let("tex_endinput:D", "endinput");
-    eval_let("tex_inputlineno:D", "inputlineno");
-    eval_let("tex_errmessage:D", "errmessage");
-    eval_let("tex_message:D", "message");
-    eval_let("tex_show:D", "show");
-    eval_let("tex_showthe:D", "showthe");
-    eval_let("tex_showbox:D", "showbox");
-    eval_let("tex_showlists:D", "showlists");
-    eval_let("tex_errhelp:D", "errhelp");
-    eval_let("tex_errorcontextlines:D", "errorcontextlines");
-    eval_let("tex_tracingcommands:D", "tracingcommands");
-    eval_let("tex_tracinglostchars:D", "tracinglostchars");
-    eval_let("tex_tracingmacros:D", "tracingmacros");
-    eval_let("tex_tracingonline:D", "tracingonline");
-    eval_let("tex_tracingoutput:D", "tracingoutput");
-    eval_let("tex_tracingpages:D", "tracingpages");
-    eval_let("tex_tracingparagraphs:D", "tracingparagraphs");
-    eval_let("tex_tracingrestores:D", "tracingrestores");
-    eval_let("tex_tracingstats:D", "tracingstats");
-    eval_let("tex_pausing:D", "pausing");
-    eval_let("tex_showboxbreadth:D", "showboxbreadth");
-    eval_let("tex_showboxdepth:D", "showboxdepth");
-    eval_let("tex_batchmode:D", "batchmode");
-    eval_let("tex_errorstopmode:D", "errorstopmode");
-    eval_let("tex_nonstopmode:D", "nonstopmode");
-    eval_let("tex_scrollmode:D", "scrollmode");
-    eval_let("tex_end:D", "end");
-    eval_let("tex_csname:D", "csname");
-    eval_let("tex_endcsname:D", "endcsname");
-    eval_let("tex_ignorespaces:D", "ignorespaces");
-    eval_let("tex_relax:D", "relax");
-    eval_let("tex_the:D", "the");
-    eval_let("tex_mag:D", "mag");
-    eval_let("tex_language:D", "language");
-    eval_let("tex_mark:D", "mark");
-    eval_let("tex_topmark:D", "topmark");
-    eval_let("tex_firstmark:D", "firstmark");
-    eval_let("tex_botmark:D", "botmark");
-    eval_let("tex_splitfirstmark:D", "splitfirstmark");
-    eval_let("tex_splitbotmark:D", "splitbotmark");
-    eval_let("tex_fontname:D", "fontname");
-    eval_let("tex_escapechar:D", "escapechar");
-    eval_let("tex_endlinechar:D", "endlinechar");
-    eval_let("tex_mathchoice:D", "mathchoice");
-    eval_let("tex_delimiter:D", "delimiter");
-    eval_let("tex_mathaccent:D", "mathaccent");
-    eval_let("tex_mathchar:D", "mathchar");
-    eval_let("tex_mskip:D", "mskip");
-    eval_let("tex_radical:D", "radical");
-    eval_let("tex_vcenter:D", "vcenter");
-    eval_let("tex_mkern:D", "mkern");
-    eval_let("tex_above:D", "above");
-    eval_let("tex_abovewithdelims:D", "abovewithdelims");
-    eval_let("tex_atop:D", "atop");
-    eval_let("tex_atopwithdelims:D", "atopwithdelims");
-    eval_let("tex_over:D", "over");
-    eval_let("tex_overwithdelims:D", "overwithdelims");
-    eval_let("tex_displaystyle:D", "displaystyle");
-    eval_let("tex_textstyle:D", "textstyle");
-    eval_let("tex_scriptscriptstyle:D", "scriptscriptstyle");
-    eval_let("tex_scriptstyle:D", "scriptstyle");
-    eval_let("tex_nonscript:D", "nonscript");
-    eval_let("tex_eqno:D", "eqno");
-    eval_let("tex_abovedisplayshortskip:D", "abovedisplayshortskip");
-    eval_let("tex_abovedisplayskip:D", "abovedisplayskip");
-    eval_let("tex_belowdisplayshortskip:D", "belowdisplayshortskip");
-    eval_let("tex_belowdisplayskip:D", "belowdisplayskip");
-    eval_let("tex_displaywidowpenalty:D", "displaywidowpenalty");
-    eval_let("tex_displayindent:D", "displayindent");
-    eval_let("tex_displaywidth:D", "displaywidth");
-    eval_let("tex_everydisplay:D", "everydisplay");
-    eval_let("tex_predisplaysize:D", "predisplaysize");
-    eval_let("tex_predisplaypenalty:D", "predisplaypenalty");
-    eval_let("tex_postdisplaypenalty:D", "postdisplaypenalty");
-    eval_let("tex_mathbin:D", "mathbin");
-    eval_let("tex_mathclose:D", "mathclose");
-    eval_let("tex_mathinner:D", "mathinner");
-    eval_let("tex_mathop:D", "mathop");
-    eval_let("tex_displaylimits:D", "displaylimits");
-    eval_let("tex_limits:D", "limits");
-    eval_let("tex_nolimits:D", "nolimits");
-    eval_let("tex_mathopen:D", "mathopen");
-    eval_let("tex_mathord:D", "mathord");
-    eval_let("tex_mathpunct:D", "mathpunct");
-    eval_let("tex_mathpunct:D", "mathpunct");
-    eval_let("tex_mathrel:D", "mathrel");
-    eval_let("tex_overline:D", "overline");
-    eval_let("tex_underline:D", "underline");
-    eval_let("tex_left:D", "left");
-    eval_let("tex_right:D", "right");
-    eval_let("tex_binoppenalty:D", "binoppenalty");
-    eval_let("tex_relpenalty:D", "relpenalty");
-    eval_let("tex_delimitershortfall:D", "delimitershortfall");
-    eval_let("tex_delimiterfactor:D", "delimiterfactor");
-    eval_let("tex_nulldelimiterspace:D", "nulldelimiterspace");
-    eval_let("tex_everymath:D", "everymath");
-    eval_let("tex_mathsurround:D", "mathsurround");
-    eval_let("tex_medmuskip:D", "medmuskip");
-    eval_let("tex_thinmuskip:D", "thinmuskip");
-    eval_let("tex_thickmuskip:D", "thickmuskip");
-    eval_let("tex_scriptspace:D", "scriptspace");
-    eval_let("tex_noboundary:D", "noboundary");
-    eval_let("tex_char:D", "char");
-    eval_let("tex_discretionary:D", "discretionary");
-    eval_let("tex_hfil:D", "hfil");
-    eval_let("tex_hfilneg:D", "hfilneg");
-    eval_let("tex_hfill:D", "hfill");
-    eval_let("tex_hskip:D", "hskip");
-    eval_let("tex_hss:D", "hss");
-    eval_let("tex_vfil:D", "vfil");
-    eval_let("tex_vfilneg:D", "vfilneg");
-    eval_let("tex_vfill:D", "vfill");
-    eval_let("tex_vskip:D", "vskip");
-    eval_let("tex_vss:D", "vss");
-    eval_let("tex_unskip:D", "unskip");
-    eval_let("tex_kern:D", "kern");
-    eval_let("tex_unkern:D", "unkern");
-    eval_let("tex_hrule:D", "hrule");
-    eval_let("tex_vrule:D", "vrule");
-    eval_let("tex_leaders:D", "leaders");
-    eval_let("tex_cleaders:D", "cleaders");
-    eval_let("tex_xleaders:D", "xleaders");
-    eval_let("tex_lastkern:D", "lastkern");
-    eval_let("tex_lastskip:D", "lastskip");
-    eval_let("tex_indent:D", "indent");
-    eval_let("tex_par:D", "par");
-    eval_let("tex_noindent:D", "noindent");
-    eval_let("tex_vadjust:D", "vadjust");
-    eval_let("tex_baselineskip:D", "baselineskip");
-    eval_let("tex_lineskip:D", "lineskip");
-    eval_let("tex_lineskiplimit:D", "lineskiplimit");
-    eval_let("tex_clubpenalty:D", "clubpenalty");
-    eval_let("tex_widowpenalty:D", "widowpenalty");
-    eval_let("tex_exhyphenpenalty:D", "exhyphenpenalty");
-    eval_let("tex_hyphenpenalty:D", "hyphenpenalty");
-    eval_let("tex_linepenalty:D", "linepenalty");
-    eval_let("tex_doublehyphendemerits:D", "doublehyphendemerits");
-    eval_let("tex_finalhyphendemerits:D", "finalhyphendemerits");
-    eval_let("tex_adjdemerits:D", "adjdemerits");
-    eval_let("tex_hangafter:D", "hangafter");
-    eval_let("tex_hangindent:D", "hangindent");
-    eval_let("tex_parshape:D", "parshape");
-    eval_let("tex_hsize:D", "hsize");
-    eval_let("tex_lefthyphenmin:D", "lefthyphenmin");
-    eval_let("tex_righthyphenmin:D", "righthyphenmin");
-    eval_let("tex_leftskip:D", "leftskip");
-    eval_let("tex_rightskip:D", "rightskip");
-    eval_let("tex_looseness:D", "looseness");
-    eval_let("tex_parskip:D", "parskip");
-    eval_let("tex_parindent:D", "parindent");
-    eval_let("tex_uchyph:D", "uchyph");
-    eval_let("tex_emergencystretch:D", "emergencystretch");
-    eval_let("tex_pretolerance:D", "pretolerance");
-    eval_let("tex_tolerance:D", "tolerance");
-    eval_let("tex_spaceskip:D", "spaceskip");
-    eval_let("tex_xspaceskip:D", "xspaceskip");
-    eval_let("tex_parfillskip:D", "parfillskip");
-    eval_let("tex_everypar:D", "everypar");
-    eval_let("tex_prevgraf:D", "prevgraf");
-    eval_let("tex_spacefactor:D", "spacefactor");
-    eval_let("tex_shipout:D", "shipout");
-    eval_let("tex_vsize:D", "vsize");
-    eval_let("tex_interlinepenalty:D", "interlinepenalty");
-    eval_let("tex_brokenpenalty:D", "brokenpenalty");
-    eval_let("tex_topskip:D", "topskip");
-    eval_let("tex_maxdeadcycles:D", "maxdeadcycles");
-    eval_let("tex_maxdepth:D", "maxdepth");
-    eval_let("tex_output:D", "output");
-    eval_let("tex_deadcycles:D", "deadcycles");
-    eval_let("tex_pagedepth:D", "pagedepth");
-    eval_let("tex_pagestretch:D", "pagestretch");
-    eval_let("tex_pagefilstretch:D", "pagefilstretch");
-    eval_let("tex_pagefillstretch:D", "pagefillstretch");
-    eval_let("tex_pagefilllstretch:D", "pagefilllstretch");
-    eval_let("tex_pageshrink:D", "pageshrink");
-    eval_let("tex_pagegoal:D", "pagegoal");
-    eval_let("tex_pagetotal:D", "pagetotal");
-    eval_let("tex_outputpenalty:D", "outputpenalty");
-    eval_let("tex_hoffset:D", "hoffset");
-    eval_let("tex_voffset:D", "voffset");
-    eval_let("tex_insert:D", "insert");
-    eval_let("tex_holdinginserts:D", "holdinginserts");
-    eval_let("tex_floatingpenalty:D", "floatingpenalty");
-    eval_let("tex_insertpenalties:D", "insertpenalties");
-    eval_let("tex_lower:D", "lower");
-    eval_let("tex_moveleft:D", "moveleft");
-    eval_let("tex_moveright:D", "moveright");
-    eval_let("tex_raise:D", "raise");
-    eval_let("tex_copy:D", "copy");
-    eval_let("tex_lastbox:D", "lastbox");
-    eval_let("tex_vsplit:D", "vsplit");
-    eval_let("tex_unhbox:D", "unhbox");
-    eval_let("tex_unhcopy:D", "unhcopy");
-    eval_let("tex_unvbox:D", "unvbox");
-    eval_let("tex_unvcopy:D", "unvcopy");
-    eval_let("tex_setbox:D", "setbox");
-    eval_let("tex_hbox:D", "hbox");
-    eval_let("tex_vbox:D", "vbox");
-    eval_let("tex_vtop:D", "vtop");
-    eval_let("tex_prevdepth:D", "prevdepth");
-    eval_let("tex_badness:D", "badness");
-    eval_let("tex_hbadness:D", "hbadness");
-    eval_let("tex_vbadness:D", "vbadness");
-    eval_let("tex_hfuzz:D", "hfuzz");
-    eval_let("tex_vfuzz:D", "vfuzz");
-    eval_let("tex_overfullrule:D", "overfullrule");
-    eval_let("tex_boxmaxdepth:D", "boxmaxdepth");
-    eval_let("tex_splitmaxdepth:D", "splitmaxdepth");
-    eval_let("tex_splittopskip:D", "splittopskip");
-    eval_let("tex_everyhbox:D", "everyhbox");
-    eval_let("tex_everyvbox:D", "everyvbox");
-    eval_let("tex_nullfont:D", "nullfont");
-    eval_let("tex_textfont:D", "textfont");
-    eval_let("tex_scriptfont:D", "scriptfont");
-    eval_let("tex_scriptscriptfont:D", "scriptscriptfont");
-    eval_let("tex_fontdimen:D", "fontdimen");
-    eval_let("tex_hyphenchar:D", "hyphenchar");
-    eval_let("tex_skewchar:D", "skewchar");
-    eval_let("tex_defaulthyphenchar:D", "defaulthyphenchar");
-    eval_let("tex_defaultskewchar:D", "defaultskewchar");
-    eval_let("tex_number:D", "number");
-    eval_let("tex_romannumeral:D", "romannumeral");
-    eval_let("tex_string:D", "string");
-    eval_let("tex_lowercase:D", "lowercase");
-    eval_let("tex_uppercase:D", "uppercase");
-    eval_let("tex_meaning:D", "meaning");
-    eval_let("tex_penalty:D", "penalty");
-    eval_let("tex_unpenalty:D", "unpenalty");
-    eval_let("tex_lastpenalty:D", "lastpenalty");
-    eval_let("tex_special:D", "special");
-    eval_let("tex_dump:D", "dump");
-    eval_let("tex_patterns:D", "patterns");
-    eval_let("tex_hyphenation:D", "hyphenation");
-    eval_let("tex_time:D", "time");
-    eval_let("tex_day:D", "day");
-    eval_let("tex_month:D", "month");
-    eval_let("tex_year:D", "year");
-    eval_let("tex_jobname:D", "jobname");
-    eval_let("tex_everyjob:D", "everyjob");
-    eval_let("tex_count:D", "count");
-    eval_let("tex_dimen:D", "dimen");
-    eval_let("tex_skip:D", "skip");
-    eval_let("tex_toks:D", "toks");
-    eval_let("tex_muskip:D", "muskip");
-    eval_let("tex_box:D", "box");
-    eval_let("tex_wd:D", "wd");
-    eval_let("tex_ht:D", "ht");
-    eval_let("tex_dp:D", "dp");
-    eval_let("tex_catcode:D", "catcode");
-    eval_let("tex_delcode:D", "delcode");
-    eval_let("tex_sfcode:D", "sfcode");
-    eval_let("tex_lccode:D", "lccode");
-    eval_let("tex_uccode:D", "uccode");
-    eval_let("tex_mathcode:D", "mathcode");
-    eval_let("etex_ifdefined:D", "ifdefined");
-    eval_let("etex_ifcsname:D", "ifcsname");
-    eval_let("etex_unless:D", "unless");
-    eval_let("etex_eTeXversion:D", "eTeXversion");
-    eval_let("etex_eTeXrevision:D", "eTeXrevision");
-    eval_let("etex_marks:D", "marks");
-    eval_let("etex_topmarks:D", "topmarks");
-    eval_let("etex_firstmarks:D", "firstmarks");
-    eval_let("etex_botmarks:D", "botmarks");
-    eval_let("etex_splitfirstmarks:D", "splitfirstmarks");
-    eval_let("etex_splitbotmarks:D", "splitbotmarks");
-    eval_let("etex_unexpanded:D", "unexpanded");
-    eval_let("etex_detokenize:D", "detokenize");
-    eval_let("etex_scantokens:D", "scantokens");
-    eval_let("etex_showtokens:D", "showtokens");
-    eval_let("etex_readline:D", "readline");
-    eval_let("etex_tracingassigns:D", "tracingassigns");
-    eval_let("etex_tracingscantokens:D", "tracingscantokens");
-    eval_let("etex_tracingnesting:D", "tracingnesting");
-    eval_let("etex_tracingifs:D", "tracingifs");
-    eval_let("etex_currentiflevel:D", "currentiflevel");
-    eval_let("etex_currentifbranch:D", "currentifbranch");
-    eval_let("etex_currentiftype:D", "currentiftype");
-    eval_let("etex_tracinggroups:D", "tracinggroups");
-    eval_let("etex_currentgrouplevel:D", "currentgrouplevel");
-    eval_let("etex_currentgrouptype:D", "currentgrouptype");
-    eval_let("etex_showgroups:D", "showgroups");
-    eval_let("etex_showifs:D", "showifs");
-    eval_let("etex_interactionmode:D", "interactionmode");
-    eval_let("etex_lastnodetype:D", "lastnodetype");
-    eval_let("etex_iffontchar:D", "iffontchar");
-    eval_let("etex_fontcharht:D", "fontcharht");
-    eval_let("etex_fontchardp:D", "fontchardp");
-    eval_let("etex_fontcharwd:D", "fontcharwd");
-    eval_let("etex_fontcharic:D", "fontcharic");
-    eval_let("etex_parshapeindent:D", "parshapeindent");
-    eval_let("etex_parshapelength:D", "parshapelength");
-    eval_let("etex_parshapedimen:D", "parshapedimen");
-    eval_let("etex_numexpr:D", "numexpr");
-    eval_let("etex_dimexpr:D", "dimexpr");
-    eval_let("etex_glueexpr:D", "glueexpr");
-    eval_let("etex_muexpr:D", "muexpr");
-    eval_let("etex_gluestretch:D", "gluestretch");
-    eval_let("etex_glueshrink:D", "glueshrink");
-    eval_let("etexgluestretchorder_:D", "gluestretchorder");
-    eval_let("etex_glueshrinkorder:D", "glueshrinkorder");
-    eval_let("etex_gluetomu:D", "gluetomu");
-    eval_let("etex_mutoglue:D", "mutoglue");
-    eval_let("etex_lastlinefit:D", "lastlinefit");
-    eval_let("etex_interlinepenalties:D", "interlinepenalties");
-    eval_let("etex_clubpenalties:D", "clubpenalties");
-    eval_let("etex_widowpenalties:D", "widowpenalties");
-    eval_let("etex_displaywidowpenalties:D", "displaywidowpenalties");
-    eval_let("etex_middle:D", "middle");
-    eval_let("etex_savinghyphcodes:D", "savinghyphcodes");
-    eval_let("etex_savingvdiscards:D", "savingvdiscards");
-    eval_let("etex_pagediscards:D", "pagediscards");
-    eval_let("etex_splitdiscards:D", "splitdiscards");
-    eval_let("etex_TeXXeTstate:D", "TeXXeTstate");
-    eval_let("etex_beginL:D", "beginL");
-    eval_let("etex_endL:D", "endL");
-    eval_let("etex_beginR:D", "beginR");
-    eval_let("etex_endR:D", "endR");
-    eval_let("etex_predisplaydirection:D", "predisplaydirection");
-    eval_let("etex_everyeof:D", "everyeof");
-    eval_let("etex_protected:D", "protected");
-    eval_let("pdftex_strcmp:D", "pdfstrcmp");
-
-    // Definition of frozen@ ... without the unimp code
-    // \let\frozen@everymath\everymath \let\frozen@everydisplay\everydisplay
-    // \newtoks\everymath \newtoks\everydisplay
-    // \frozen@everymath = {\the\everymath}
-    // \frozen@everydisplay = {\the\everydisplay}
-    // possible redef
-    eval_let("tex_end:D", "@@end");
-    eval_let("tex_input:D", "@@input");
-    // eval_let("tex_underline:D", "@@underline"); // math only \underline
-    // eval_let("tex_hyphen:D", "@@hyp");  is \-
-    // eval_let("\tex_italiccorrection:D", "@@italiccorr");  is \/
-    // eval_let("tex_everydisplay:D", "frozen@everydisplay"); not needed ?
-    // eval_let("tex_everymath:D", "frozen@everymath")
-
-    // other redefinitions
-    eval_let("if_true:", "tex_iftrue:D");
-    eval_let("if_false:", "tex_iffalse:D");
-    eval_let("or:", "tex_or:D");
-    eval_let("else:", "tex_else:D");
-    eval_let("fi:", "tex_fi:D");
-    eval_let("reverse_if:N", "etex_unless:D");
-    eval_let("if:w", "tex_if:D");
-    eval_let("if_charcode:w", "tex_if:D");
-    eval_let("if_catcode:w", "tex_ifcat:D");
-    eval_let("if_meaning:w", "tex_ifx:D");
-    eval_let("if_mode_math:", "tex_ifmmode:D");
-    eval_let("if_mode_horizontal:", "tex_ifhmode:D");
-    eval_let("if_mode_vertical:", "tex_ifvmode:D");
-    eval_let("if_mode_inner:", "tex_ifinner:D");
-    eval_let("if_cs_exist:N", "etex_ifdefined:D");
-    eval_let("if_cs_exist:w", "etex_ifcsname:D");
-    eval_let("cs:w", "tex_csname:D");
-    eval_let("cs_end:", "tex_endcsname:D");
-    eval_let("exp_after:wN", "tex_expandafter:D");
-    T_exp_notN = eval_letv("exp_not:N", "tex_noexpand:D");
-    T_exp_notn = eval_letv("exp_not:n", "etex_unexpanded:D");
-    eval_let("token_to_meaning:N", "tex_meaning:D");
-    eval_let("token_to_str:N", "tex_string:D");
-    eval_let("cs_meaning:N", "tex_meaning:D");
-    eval_let("scan_stop:", "tex_relax:D");
-    eval_let("group_begin:", "tex_begingroup:D");
-    eval_let("group_end:", "tex_endgroup:D");
-    eval_let("if_int_compare:w", "tex_ifnum:D");
-    T_roman = eval_letv("__int_to_roman:w", "tex_romannumeral:D");
-    eval_let("group_insert_after:N", "tex_aftergroup:D");
+namespace {
+    // The tex_xxx:D and etex_xxx:D names, and the primitives they are let to.
+    const std::pair<String, String> l3_tex_names[] = {
+        {"tex_space:D", " "},
+        {"tex_italiccorrection:D", "/"},
+        {"tex_hyphen:D", "-"},
+        {"tex_let:D", "let"},
+        {"tex_def:D", "def"},
+        {"tex_edef:D", "edef"},
+        {"tex_gdef:D", "gdef"},
+        {"tex_xdef:D", "xdef"},
+        {"tex_chardef:D", "chardef"},
+        {"tex_countdef:D", "countdef"},
+        {"tex_dimendef:D", "dimendef"},
+        {"tex_skipdef:D", "skipdef"},
+        {"tex_muskipdef:D", "muskipdef"},
+        {"tex_mathchardef:D", "mathchardef"},
+        {"tex_toksdef:D", "toksdef"},
+        {"tex_futurelet:D", "futurelet"},
+        {"tex_advance:D", "advance"},
+        {"tex_divide:D", "divide"},
+        {"tex_multiply:D", "multiply"},
+        {"tex_font:D", "font"},
+        {"tex_fam:D", "fam"},
+        {"tex_global:D", "global"},
+        {"tex_long:D", "long"},
+        {"tex_outer:D", "outer"},
+        {"tex_setlanguage:D", "setlanguage"},
+        {"tex_setlanguage:D", "setlanguage"},
+        {"tex_globaldefs:D", "globaldefs"},
+        {"tex_afterassignment:D", "afterassignment"},
+        {"tex_aftergroup:D", "aftergroup"},
+        {"tex_expandafter:D", "expandafter"},
+        {"tex_noexpand:D", "noexpand"},
+        {"tex_begingroup:D", "begingroup"},
+        {"tex_endgroup:D", "endgroup"},
+        {"tex_halign:D", "halign"},
+        {"tex_valign:D", "valign"},
+        {"tex_cr:D", "cr"},
+        {"tex_crcr:D", "crcr"},
+        {"tex_noalign:D", "noalign"},
+        {"tex_omit:D", "omit"},
+        {"tex_span:D", "span"},
+        {"tex_tabskip:D", "tabskip"},
+        {"tex_everycr:D", "everycr"},
+        {"tex_if:D", "if"},
+        {"tex_ifcase:D", "ifcase"},
+        {"tex_ifcat:D", "ifcat"},
+        {"tex_ifnum:D", "ifnum"},
+        {"tex_ifodd:D", "ifodd"},
+        {"tex_ifdim:D", "ifdim"},
+        {"tex_ifeof:D", "ifeof"},
+        {"tex_ifhbox:D", "ifhbox"},
+        {"tex_ifvbox:D", "ifvbox"},
+        {"tex_ifvoid:D", "ifvoid"},
+        {"tex_ifx:D", "ifx"},
+        {"tex_iffalse:D", "iffalse"},
+        {"tex_iftrue:D", "iftrue"},
+        {"tex_ifhmode:D", "ifhmode"},
+        {"tex_ifmmode:D", "ifmmode"},
+        {"tex_ifvmode:D", "ifvmode"},
+        {"tex_ifinner:D", "ifinner"},
+        {"tex_fi:D", "fi"},
+        {"tex_else:D", "else"},
+        {"tex_or:D", "or"},
+        {"tex_immediate:D", "immediate"},
+        {"tex_closeout:D", "closeout"},
+        {"tex_openin:D", "openin"},
+        {"tex_openout:D", "openout"},
+        {"tex_read:D", "read"},
+        {"tex_write:D", "write"},
+        {"tex_closein:D", "closein"},
+        {"tex_newlinechar:D", "newlinechar"},
+        {"tex_input:D", "input"},
+        {"tex_endinput:D", "endinput"},
+        {"tex_inputlineno:D", "inputlineno"},
+        {"tex_errmessage:D", "errmessage"},
+        {"tex_message:D", "message"},
+        {"tex_show:D", "show"},
+        {"tex_showthe:D", "showthe"},
+        {"tex_showbox:D", "showbox"},
+        {"tex_showlists:D", "showlists"},
+        {"tex_errhelp:D", "errhelp"},
+        {"tex_errorcontextlines:D", "errorcontextlines"},
+        {"tex_tracingcommands:D", "tracingcommands"},
+        {"tex_tracinglostchars:D", "tracinglostchars"},
+        {"tex_tracingmacros:D", "tracingmacros"},
+        {"tex_tracingonline:D", "tracingonline"},
+        {"tex_tracingoutput:D", "tracingoutput"},
+        {"tex_tracingpages:D", "tracingpages"},
+        {"tex_tracingparagraphs:D", "tracingparagraphs"},
+        {"tex_tracingrestores:D", "tracingrestores"},
+        {"tex_tracingstats:D", "tracingstats"},
+        {"tex_pausing:D", "pausing"},
+        {"tex_showboxbreadth:D", "showboxbreadth"},
+        {"tex_showboxdepth:D", "showboxdepth"},
+        {"tex_batchmode:D", "batchmode"},
+        {"tex_errorstopmode:D", "errorstopmode"},
+        {"tex_nonstopmode:D", "nonstopmode"},
+        {"tex_scrollmode:D", "scrollmode"},
+        {"tex_end:D", "end"},
+        {"tex_csname:D", "csname"},
+        {"tex_endcsname:D", "endcsname"},
+        {"tex_ignorespaces:D", "ignorespaces"},
+        {"tex_relax:D", "relax"},
+        {"tex_the:D", "the"},
+        {"tex_mag:D", "mag"},
+        {"tex_language:D", "language"},
+        {"tex_mark:D", "mark"},
+        {"tex_topmark:D", "topmark"},
+        {"tex_firstmark:D", "firstmark"},
+        {"tex_botmark:D", "botmark"},
+        {"tex_splitfirstmark:D", "splitfirstmark"},
+        {"tex_splitbotmark:D", "splitbotmark"},
+        {"tex_fontname:D", "fontname"},
+        {"tex_escapechar:D", "escapechar"},
+        {"tex_endlinechar:D", "endlinechar"},
+        {"tex_mathchoice:D", "mathchoice"},
+        {"tex_delimiter:D", "delimiter"},
+        {"tex_mathaccent:D", "mathaccent"},
+        {"tex_mathchar:D", "mathchar"},
+        {"tex_mskip:D", "mskip"},
+        {"tex_radical:D", "radical"},
+        {"tex_vcenter:D", "vcenter"},
+        {"tex_mkern:D", "mkern"},
+        {"tex_above:D", "above"},
+        {"tex_abovewithdelims:D", "abovewithdelims"},
+        {"tex_atop:D", "atop"},
+        {"tex_atopwithdelims:D", "atopwithdelims"},
+        {"tex_over:D", "over"},
+        {"tex_overwithdelims:D", "overwithdelims"},
+        {"tex_displaystyle:D", "displaystyle"},
+        {"tex_textstyle:D", "textstyle"},
+        {"tex_scriptscriptstyle:D", "scriptscriptstyle"},
+        {"tex_scriptstyle:D", "scriptstyle"},
+        {"tex_nonscript:D", "nonscript"},
+        {"tex_eqno:D", "eqno"},
+        {"tex_abovedisplayshortskip:D", "abovedisplayshortskip"},
+        {"tex_abovedisplayskip:D", "abovedisplayskip"},
+        {"tex_belowdisplayshortskip:D", "belowdisplayshortskip"},
+        {"tex_belowdisplayskip:D", "belowdisplayskip"},
+        {"tex_displaywidowpenalty:D", "displaywidowpenalty"},
+        {"tex_displayindent:D", "displayindent"},
+        {"tex_displaywidth:D", "displaywidth"},
+        {"tex_everydisplay:D", "everydisplay"},
+        {"tex_predisplaysize:D", "predisplaysize"},
+        {"tex_predisplaypenalty:D", "predisplaypenalty"},
+        {"tex_postdisplaypenalty:D", "postdisplaypenalty"},
+        {"tex_mathbin:D", "mathbin"},
+        {"tex_mathclose:D", "mathclose"},
+        {"tex_mathinner:D", "mathinner"},
+        {"tex_mathop:D", "mathop"},
+        {"tex_displaylimits:D", "displaylimits"},
+        {"tex_limits:D", "limits"},
+        {"tex_nolimits:D", "nolimits"},
+        {"tex_mathopen:D", "mathopen"},
+        {"tex_mathord:D", "mathord"},
+        {"tex_mathpunct:D", "mathpunct"},
+        {"tex_mathpunct:D", "mathpunct"},
+        {"tex_mathrel:D", "mathrel"},
+        {"tex_overline:D", "overline"},
+        {"tex_underline:D", "underline"},
+        {"tex_left:D", "left"},
+        {"tex_right:D", "right"},
+        {"tex_binoppenalty:D", "binoppenalty"},
+        {"tex_relpenalty:D", "relpenalty"},
+        {"tex_delimitershortfall:D", "delimitershortfall"},
+        {"tex_delimiterfactor:D", "delimiterfactor"},
+        {"tex_nulldelimiterspace:D", "nulldelimiterspace"},
+        {"tex_everymath:D", "everymath"},
+        {"tex_mathsurround:D", "mathsurround"},
+        {"tex_medmuskip:D", "medmuskip"},
+        {"tex_thinmuskip:D", "thinmuskip"},
+        {"tex_thickmuskip:D", "thickmuskip"},
+        {"tex_scriptspace:D", "scriptspace"},
+        {"tex_noboundary:D", "noboundary"},
+        {"tex_char:D", "char"},
+        {"tex_discretionary:D", "discretionary"},
+        {"tex_hfil:D", "hfil"},
+        {"tex_hfilneg:D", "hfilneg"},
+        {"tex_hfill:D", "hfill"},
+        {"tex_hskip:D", "hskip"},
+        {"tex_hss:D", "hss"},
+        {"tex_vfil:D", "vfil"},
+        {"tex_vfilneg:D", "vfilneg"},
+        {"tex_vfill:D", "vfill"},
+        {"tex_vskip:D", "vskip"},
+        {"tex_vss:D", "vss"},
+        {"tex_unskip:D", "unskip"},
+        {"tex_kern:D", "kern"},
+        {"tex_unkern:D", "unkern"},
+        {"tex_hrule:D", "hrule"},
+        {"tex_vrule:D", "vrule"},
+        {"tex_leaders:D", "leaders"},
+        {"tex_cleaders:D", "cleaders"},
+        {"tex_xleaders:D", "xleaders"},
+        {"tex_lastkern:D", "lastkern"},
+        {"tex_lastskip:D", "lastskip"},
+        {"tex_indent:D", "indent"},
+        {"tex_par:D", "par"},
+        {"tex_noindent:D", "noindent"},
+        {"tex_vadjust:D", "vadjust"},
+        {"tex_baselineskip:D", "baselineskip"},
+        {"tex_lineskip:D", "lineskip"},
+        {"tex_lineskiplimit:D", "lineskiplimit"},
+        {"tex_clubpenalty:D", "clubpenalty"},
+        {"tex_widowpenalty:D", "widowpenalty"},
+        {"tex_exhyphenpenalty:D", "exhyphenpenalty"},
+        {"tex_hyphenpenalty:D", "hyphenpenalty"},
+        {"tex_linepenalty:D", "linepenalty"},
+        {"tex_doublehyphendemerits:D", "doublehyphendemerits"},
+        {"tex_finalhyphendemerits:D", "finalhyphendemerits"},
+        {"tex_adjdemerits:D", "adjdemerits"},
+        {"tex_hangafter:D", "hangafter"},
+        {"tex_hangindent:D", "hangindent"},
+        {"tex_parshape:D", "parshape"},
+        {"tex_hsize:D", "hsize"},
+        {"tex_lefthyphenmin:D", "lefthyphenmin"},
+        {"tex_righthyphenmin:D", "righthyphenmin"},
+        {"tex_leftskip:D", "leftskip"},
+        {"tex_rightskip:D", "rightskip"},
+        {"tex_looseness:D", "looseness"},
+        {"tex_parskip:D", "parskip"},
+        {"tex_parindent:D", "parindent"},
+        {"tex_uchyph:D", "uchyph"},
+        {"tex_emergencystretch:D", "emergencystretch"},
+        {"tex_pretolerance:D", "pretolerance"},
+        {"tex_tolerance:D", "tolerance"},
+        {"tex_spaceskip:D", "spaceskip"},
+        {"tex_xspaceskip:D", "xspaceskip"},
+        {"tex_parfillskip:D", "parfillskip"},
+        {"tex_everypar:D", "everypar"},
+        {"tex_prevgraf:D", "prevgraf"},
+        {"tex_spacefactor:D", "spacefactor"},
+        {"tex_shipout:D", "shipout"},
+        {"tex_vsize:D", "vsize"},
+        {"tex_interlinepenalty:D", "interlinepenalty"},
+        {"tex_brokenpenalty:D", "brokenpenalty"},
+        {"tex_topskip:D", "topskip"},
+        {"tex_maxdeadcycles:D", "maxdeadcycles"},
+        {"tex_maxdepth:D", "maxdepth"},
+        {"tex_output:D", "output"},
+        {"tex_deadcycles:D", "deadcycles"},
+        {"tex_pagedepth:D", "pagedepth"},
+        {"tex_pagestretch:D", "pagestretch"},
+        {"tex_pagefilstretch:D", "pagefilstretch"},
+        {"tex_pagefillstretch:D", "pagefillstretch"},
+        {"tex_pagefilllstretch:D", "pagefilllstretch"},
+        {"tex_pageshrink:D", "pageshrink"},
+        {"tex_pagegoal:D", "pagegoal"},
+        {"tex_pagetotal:D", "pagetotal"},
+        {"tex_outputpenalty:D", "outputpenalty"},
+        {"tex_hoffset:D", "hoffset"},
+        {"tex_voffset:D", "voffset"},
+        {"tex_insert:D", "insert"},
+        {"tex_holdinginserts:D", "holdinginserts"},
+        {"tex_floatingpenalty:D", "floatingpenalty"},
+        {"tex_insertpenalties:D", "insertpenalties"},
+        {"tex_lower:D", "lower"},
+        {"tex_moveleft:D", "moveleft"},
+        {"tex_moveright:D", "moveright"},
+        {"tex_raise:D", "raise"},
+        {"tex_copy:D", "copy"},
+        {"tex_lastbox:D", "lastbox"},
+        {"tex_vsplit:D", "vsplit"},
+        {"tex_unhbox:D", "unhbox"},
+        {"tex_unhcopy:D", "unhcopy"},
+        {"tex_unvbox:D", "unvbox"},
+        {"tex_unvcopy:D", "unvcopy"},
+        {"tex_setbox:D", "setbox"},
+        {"tex_hbox:D", "hbox"},
+        {"tex_vbox:D", "vbox"},
+        {"tex_vtop:D", "vtop"},
+        {"tex_prevdepth:D", "prevdepth"},
+        {"tex_badness:D", "badness"},
+        {"tex_hbadness:D", "hbadness"},
+        {"tex_vbadness:D", "vbadness"},
+        {"tex_hfuzz:D", "hfuzz"},
+        {"tex_vfuzz:D", "vfuzz"},
+        {"tex_overfullrule:D", "overfullrule"},
+        {"tex_boxmaxdepth:D", "boxmaxdepth"},
+        {"tex_splitmaxdepth:D", "splitmaxdepth"},
+        {"tex_splittopskip:D", "splittopskip"},
+        {"tex_everyhbox:D", "everyhbox"},
+        {"tex_everyvbox:D", "everyvbox"},
+        {"tex_nullfont:D", "nullfont"},
+        {"tex_textfont:D", "textfont"},
+        {"tex_scriptfont:D", "scriptfont"},
+        {"tex_scriptscriptfont:D", "scriptscriptfont"},
+        {"tex_fontdimen:D", "fontdimen"},
+        {"tex_hyphenchar:D", "hyphenchar"},
+        {"tex_skewchar:D", "skewchar"},
+        {"tex_defaulthyphenchar:D", "defaulthyphenchar"},
+        {"tex_defaultskewchar:D", "defaultskewchar"},
+        {"tex_number:D", "number"},
+        {"tex_romannumeral:D", "romannumeral"},
+        {"tex_string:D", "string"},
+        {"tex_lowercase:D", "lowercase"},
+        {"tex_uppercase:D", "uppercase"},
+        {"tex_meaning:D", "meaning"},
+        {"tex_penalty:D", "penalty"},
+        {"tex_unpenalty:D", "unpenalty"},
+        {"tex_lastpenalty:D", "lastpenalty"},
+        {"tex_special:D", "special"},
+        {"tex_dump:D", "dump"},
+        {"tex_patterns:D", "patterns"},
+        {"tex_hyphenation:D", "hyphenation"},
+        {"tex_time:D", "time"},
+        {"tex_day:D", "day"},
+        {"tex_month:D", "month"},
+        {"tex_year:D", "year"},
+        {"tex_jobname:D", "jobname"},
+        {"tex_everyjob:D", "everyjob"},
+        {"tex_count:D", "count"},
+        {"tex_dimen:D", "dimen"},
+        {"tex_skip:D", "skip"},
+        {"tex_toks:D", "toks"},
+        {"tex_muskip:D", "muskip"},
+        {"tex_box:D", "box"},
+        {"tex_wd:D", "wd"},
+        {"tex_ht:D", "ht"},
+        {"tex_dp:D", "dp"},
+        {"tex_catcode:D", "catcode"},
+        {"tex_delcode:D", "delcode"},
+        {"tex_sfcode:D", "sfcode"},
+        {"tex_lccode:D", "lccode"},
+        {"tex_uccode:D", "uccode"},
+        {"tex_mathcode:D", "mathcode"},
+        {"etex_ifdefined:D", "ifdefined"},
+        {"etex_ifcsname:D", "ifcsname"},
+        {"etex_unless:D", "unless"},
+        {"etex_eTeXversion:D", "eTeXversion"},
+        {"etex_eTeXrevision:D", "eTeXrevision"},
+        {"etex_marks:D", "marks"},
+        {"etex_topmarks:D", "topmarks"},
+        {"etex_firstmarks:D", "firstmarks"},
+        {"etex_botmarks:D", "botmarks"},
+        {"etex_splitfirstmarks:D", "splitfirstmarks"},
+        {"etex_splitbotmarks:D", "splitbotmarks"},
+        {"etex_unexpanded:D", "unexpanded"},
+        {"etex_detokenize:D", "detokenize"},
+        {"etex_scantokens:D", "scantokens"},
+        {"etex_showtokens:D", "showtokens"},
+        {"etex_readline:D", "readline"},
+        {"etex_tracingassigns:D", "tracingassigns"},
+        {"etex_tracingscantokens:D", "tracingscantokens"},
+        {"etex_tracingnesting:D", "tracingnesting"},
+        {"etex_tracingifs:D", "tracingifs"},
+        {"etex_currentiflevel:D", "currentiflevel"},
+        {"etex_currentifbranch:D", "currentifbranch"},
+        {"etex_currentiftype:D", "currentiftype"},
+        {"etex_tracinggroups:D", "tracinggroups"},
+        {"etex_currentgrouplevel:D", "currentgrouplevel"},
+        {"etex_currentgrouptype:D", "currentgrouptype"},
+        {"etex_showgroups:D", "showgroups"},
+        {"etex_showifs:D", "showifs"},
+        {"etex_interactionmode:D", "interactionmode"},
+        {"etex_lastnodetype:D", "lastnodetype"},
+        {"etex_iffontchar:D", "iffontchar"},
+        {"etex_fontcharht:D", "fontcharht"},
+        {"etex_fontchardp:D", "fontchardp"},
+        {"etex_fontcharwd:D", "fontcharwd"},
+        {"etex_fontcharic:D", "fontcharic"},
+        {"etex_parshapeindent:D", "parshapeindent"},
+        {"etex_parshapelength:D", "parshapelength"},
+        {"etex_parshapedimen:D", "parshapedimen"},
+        {"etex_numexpr:D", "numexpr"},
+        {"etex_dimexpr:D", "dimexpr"},
+        {"etex_glueexpr:D", "glueexpr"},
+        {"etex_muexpr:D", "muexpr"},
+        {"etex_gluestretch:D", "gluestretch"},
+        {"etex_glueshrink:D", "glueshrink"},
+        {"etexgluestretchorder_:D", "gluestretchorder"},
+        {"etex_glueshrinkorder:D", "glueshrinkorder"},
+        {"etex_gluetomu:D", "gluetomu"},
+        {"etex_mutoglue:D", "mutoglue"},
+        {"etex_lastlinefit:D", "lastlinefit"},
+        {"etex_interlinepenalties:D", "interlinepenalties"},
+        {"etex_clubpenalties:D", "clubpenalties"},
+        {"etex_widowpenalties:D", "widowpenalties"},
+        {"etex_displaywidowpenalties:D", "displaywidowpenalties"},
+        {"etex_middle:D", "middle"},
+        {"etex_savinghyphcodes:D", "savinghyphcodes"},
+        {"etex_savingvdiscards:D", "savingvdiscards"},
+        {"etex_pagediscards:D", "pagediscards"},
+        {"etex_splitdiscards:D", "splitdiscards"},
+        {"etex_TeXXeTstate:D", "TeXXeTstate"},
+        {"etex_beginL:D", "beginL"},
+        {"etex_endL:D", "endL"},
+        {"etex_beginR:D", "beginR"},
+        {"etex_endR:D", "endR"},
+        {"etex_predisplaydirection:D", "predisplaydirection"},
+        {"etex_everyeof:D", "everyeof"},
+        {"etex_protected:D", "protected"},
+        {"pdftex_strcmp:D", "pdfstrcmp"},
+        // Definition of frozen@ ... without the unimp code
+        // \let\frozen@everymath\everymath \let\frozen@everydisplay\everydisplay
+        // \newtoks\everymath \newtoks\everydisplay
+        // \frozen@everymath = {\the\everymath}
+        // \frozen@everydisplay = {\the\everydisplay}
+        // possible redef
+        {"tex_end:D", "@@end"},
+        {"tex_input:D", "@@input"},
+        // {"tex_underline:D", "@@underline"}, // math only \underline
+        // {"tex_hyphen:D", "@@hyp"},  is \-
+        // {"tex_italiccorrection:D", "@@italiccorr"},  is \/
+        // {"tex_everydisplay:D", "frozen@everydisplay"}, not needed ?
+        // {"tex_everymath:D", "frozen@everymath"}
+    };
+    std::vector<CmdChr> l3_tex_meanings; // the meanings of the primitives above, when latex3 is loaded
+
+    // The modules of latex3 that are loaded on demand. A command belongs to
+    // a module if its name, without initial underscores, starts with one of
+    // the prefixes of the module, followed by an underscore or a colon.
+    struct L3Prefix {
+        String prefix;
+        size_t module;
+    };
+    const L3Prefix l3_prefixes[] = {{"tex", 0},  {"etex", 0}, {"etexgluestretchorder", 0}, {"pdftex", 0},
+                                    {"str", 1},  {"char", 2}, {"token", 3},                {"tl", 4}};
+    void (Hashtab::*const l3_loaders[])() = {&Hashtab::load_latex3_tex, &Hashtab::load_latex3_str, &Hashtab::load_latex3_char,
+                                             &Hashtab::load_latex3_token, &Hashtab::load_latex3_tl};
+    std::array<bool, std::size(l3_loaders)> l3_pending{};
+
+    // Returns the module of the command s, or -1.
+    auto l3_module_of(String s) -> int {
+        while (*s == '_') s++;
+        switch (*s) { // first letter of a prefix
+        case 'c':
+        case 'e':
+        case 'p':
+        case 's':
+        case 't': break;
+        default: return -1;
+        }
+        size_t n = 0;
+        while (s[n] != 0 && s[n] != '_' && s[n] != ':') n++;
+        if (s[n] == 0) return -1;
+        for (const auto &P : l3_prefixes)
+            if (strncmp(P.prefix, s, n) == 0 && P.prefix[n] == 0) return static_cast<int>(P.module);
+        return -1;
+    }
+} // namespace
+
+// Loads the part of latex3 that is needed by the parser; the other parts
+// are loaded on demand, see load_latex3_for. If preload is true, all
+// commands known so far are from Tralics, none of them is in a module.
+void Hashtab::load_latex3(bool preload) {
+    auto n = preload ? 0 : Text.size(); // number of commands that may be in a module
+    eval_let("if_true:", "iftrue");
+    eval_let("if_false:", "iffalse");
+    eval_let("or:", "or");
+    eval_let("else:", "else");
+    eval_let("fi:", "fi");
+    eval_let("reverse_if:N", "unless");
+    eval_let("if:w", "if");
+    eval_let("if_charcode:w", "if");
+    eval_let("if_catcode:w", "ifcat");
+    eval_let("if_meaning:w", "ifx");
+    eval_let("if_mode_math:", "ifmmode");
+    eval_let("if_mode_horizontal:", "ifhmode");
+    eval_let("if_mode_vertical:", "ifvmode");
+    eval_let("if_mode_inner:", "ifinner");
+    eval_let("if_cs_exist:N", "ifdefined");
+    eval_let("if_cs_exist:w", "ifcsname");
+    eval_let("cs:w", "csname");
+    eval_let("cs_end:", "endcsname");
+    eval_let("exp_after:wN", "expandafter");
+    T_exp_notN = eval_letv("exp_not:N", "noexpand");
+    T_exp_notn = eval_letv("exp_not:n", "unexpanded");
+    eval_let("token_to_meaning:N", "meaning");
+    eval_let("token_to_str:N", "string");
+    eval_let("cs_meaning:N", "meaning");
+    eval_let("scan_stop:", "relax");
+    eval_let("group_begin:", "begingroup");
+    eval_let("group_end:", "endgroup");
+    eval_let("if_int_compare:w", "ifnum");
+    T_roman = eval_letv("__int_to_roman:w", "romannumeral");
+    eval_let("group_insert_after:N", "aftergroup");
     eval_let("c_minus_one", "m@ne");
-    eval_let("cs_set_nopar:Npn", "tex_def:D");
-    eval_let("cs_set_nopar:Npx", "tex_edef:D");
-    eval_let("cs_gset_nopar:Npn", "tex_gdef:D");
-    eval_let("cs_gset_nopar:Npx", "tex_xdef:D");
+    eval_let("cs_set_nopar:Npn", "def");
+    eval_let("cs_set_nopar:Npx", "edef");
+    eval_let("cs_gset_nopar:Npn", "gdef");
+    eval_let("cs_gset_nopar:Npx", "xdef");
     T_use1 = eval_letv("use_i:nn", "@firstoftwo");
     T_use2 = eval_letv("use_ii:nn", "@secondoftwo");
-    eval_let("__int_value:w", "tex_number:D");
-    eval_let("__int_eval:w", "etex_numexpr:D");
-    eval_let("__int_eval_end:", "tex_relax:D");
-    eval_let("if_int_odd:w", "tex_ifodd:D");
-    eval_let("if_case:w", "tex_ifcase:D");
+    eval_let("__int_value:w", "number");
+    eval_let("__int_eval:w", "numexpr");
+    eval_let("__int_eval_end:", "relax");
+    eval_let("if_int_odd:w", "ifodd");
+    eval_let("if_case:w", "ifcase");
     eval_let("prg_do_nothing:", "c_empty_tl");
     T_empty = locate("c_empty_tl");
 
@@ -2351,6 +2387,21 @@ void Hashtab::load_latex3() {
     primitive("cs_if_eq:ccTF", l3_ifx_cmd, l3_TF_cc_code);
     primitive("cs_if_eq:ccT", l3_ifx_cmd, l3_T_cc_code);
     primitive("cs_if_eq:ccF", l3_ifx_cmd, l3_F_cc_code);
+
+    primitive("c_group_begin_token", open_catcode, subtypes('{'));
+    primitive("c_group_end_token", close_catcode, subtypes('}'));
+    primitive("c_math_toggle_token", dollar_catcode, subtypes('*'));
+    primitive("c_alignment_token", alignment_catcode, subtypes('*'));
+    primitive("c_parameter_token", parameter_catcode, subtypes('#'));
+    primitive("c_math_superscript_token", hat_catcode, subtypes('^'));
+    primitive("c_math_subscript_token", underscore_catcode, subtypes('*'));
+    primitive("c_space_token", space_catcode, subtypes('~'));
+    primitive("c_catcode_letter_token", letter_catcode, subtypes('a'));
+    primitive("c_catcode_other_token", other_catcode, subtypes('1'));
+    start_latex3_autoload(n);
+}
+
+void Hashtab::load_latex3_str() {
     primitive("str_if_eq_p:nn", l3str_ifeq_cmd, l3_p_code);
     primitive("str_if_eq:nnTF", l3str_ifeq_cmd, l3_TF_code);
     primitive("str_if_eq:nnT", l3str_ifeq_cmd, l3_T_code);
@@ -2394,6 +2445,9 @@ void Hashtab::load_latex3() {
     primitive("str_case:onT", l3str_case_cmd, subtypes(l3_T_code + 8));
     primitive("str_case:onF", l3str_case_cmd, subtypes(l3_F_code + 8));
     primitive("str_case:onn", l3str_case_cmd, subtypes(l3_F_code + 8));
+}
+
+void Hashtab::load_latex3_char() {
     primitive("char_set_catcode_escape:n", l3_set_cat_cmd, subtypes(escape_catcode));
     primitive("char_set_catcode_group_begin:n", l3_set_cat_cmd, subtypes(open_catcode));
     primitive("char_set_catcode_group_end:n", l3_set_cat_cmd, subtypes(close_catcode));
@@ -2441,16 +2495,26 @@ void Hashtab::load_latex3() {
     primitive("char_set_sfcode:nn", l3_set_num_cmd, setsf_code);
     primitive("char_value_sfcode:n", l3E_set_num_cmd, thesf_code);
     primitive("char_show_value_sfcode:n", l3_set_num_cmd, showsf_code);
-    primitive("c_group_begin_token", open_catcode, subtypes('{'));
-    primitive("c_group_end_token", close_catcode, subtypes('}'));
-    primitive("c_math_toggle_token", dollar_catcode, subtypes('*'));
-    primitive("c_alignment_token", alignment_catcode, subtypes('*'));
-    primitive("c_parameter_token", parameter_catcode, subtypes('#'));
-    primitive("c_math_superscript_token", hat_catcode, subtypes('^'));
-    primitive("c_math_subscript_token", underscore_catcode, subtypes('*'));
-    primitive("c_space_token", space_catcode, subtypes('~'));
-    primitive("c_catcode_letter_token", letter_catcode, subtypes('a'));
-    primitive("c_catcode_other_token", other_catcode, subtypes('1'));
+}
+
+void Hashtab::load_latex3_token() {
+    {
+        // \def\token_to_str:c{\exp_args:Nc\token_to_str:N}
+        TokenList L;
+        L.push_back(expargsnc_tok);
+        L.push_back(locate("token_to_str:N"));
+        auto *X = new Macro(L);
+        the_parser.eq_define(locate("token_to_str:c").eqtb_loc(), CmdChr(user_cmd, the_parser.mac_table.new_macro(X)), true);
+    }
+    {
+        // \def\token_new:Nn#1#2{\cs_new_eq:NN #1#2}
+        TokenList L;
+        L.push_back(locate("cs_new_eq:NN"));
+        L.push_back(Token(eol_t_offset + 1));
+        L.push_back(Token(eol_t_offset + 2));
+        auto *X = new Macro(2, dt_normal, nullptr, L);
+        the_parser.eq_define(locate("token_new:Nn").eqtb_loc(), CmdChr(user_cmd, the_parser.mac_table.new_macro(X)), true);
+    }
     primitive("token_if_group_begin_p:N", cat_ifeq_cmd, subtypes(open_catcode * 4 + l3_p_code));
     primitive("token_if_group_begin:NTF", cat_ifeq_cmd, subtypes(open_catcode * 4 + l3_TF_code));
     primitive("token_if_group_begin:NT", cat_ifeq_cmd, subtypes(open_catcode * 4 + l3_T_code));
@@ -2563,6 +2627,9 @@ void Hashtab::load_latex3() {
     primitive("token_if_skip_register:NF", token_if_cmd, subtypes(tok_if_skip_code * 4 + l3_F_code));
     primitive("token_if_toks_register:NF", token_if_cmd, subtypes(tok_if_toks_code * 4 + l3_F_code));
     primitive("token_if_primitive:NF", token_if_cmd, subtypes(tok_if_primitive_code * 4 + l3_F_code));
+}
+
+void Hashtab::load_latex3_tl() {
     primitive("tl_new:N", tl_basic_cmd, l3_tl_new_code);
     primitive("tl_clear:N", tl_basic_cmd, l3_tl_clear_code);
     primitive("tl_gclear:N", tl_basic_cmd, l3_tl_gclear_code);
@@ -2655,6 +2722,46 @@ void Hashtab::load_latex3() {
     primitive("tl_to_uppercase:n", case_shift_cmd, subtypes(7));
 }
 
+// The tex_xxx:D commands are let to the meanings the primitives had
+// when latex3 was loaded.
+void Hashtab::load_latex3_tex() {
+    for (size_t k = 0; k < l3_tex_meanings.size(); k++) {
+        auto m = l3_tex_meanings[k];
+        the_parser.eq_define(locate(l3_tex_names[k].first).eqtb_loc(), m, true);
+        if (m.is_user()) the_parser.mac_table.delete_macro_ref(m.chr);
+    }
+    l3_tex_meanings.clear();
+}
+
+// Called at the end of load_latex3. Remembers the meanings of the
+// tex_xxx:D commands; all modules are pending, but a module is loaded
+// if one of the first n commands of the hash table is in it.
+void Hashtab::start_latex3_autoload(size_t n) {
+    for (const auto &P : l3_tex_names) {
+        CmdChr m = eqtb[locate(P.second).eqtb_loc()];
+        if (m.is_user()) the_parser.mac_table.incr_macro_ref(m.chr);
+        l3_tex_meanings.push_back(m);
+    }
+    l3_pending.fill(true);
+    l3_autoload = true;
+    for (size_t p = 0; l3_autoload && p < n; p++) load_latex3_for(Text[p]);
+}
+
+// If the command s belongs to a pending module of latex3, loads the
+// module and returns true. Called when s is undefined.
+auto Hashtab::load_latex3_for(String s) -> bool {
+    auto k = l3_module_of(s);
+    if (k < 0 || !l3_pending[to_unsigned(k)]) return false;
+    l3_pending[to_unsigned(k)] = false;
+    l3_autoload                = false;
+    Buffer saved;
+    std::swap(saved, B); // the caller may use B
+    (this->*l3_loaders[k])();
+    std::swap(saved, B);
+    l3_autoload = std::any_of(l3_pending.begin(), l3_pending.end(), [](bool x) { return x; });
+    return true;
+}
+
 // TODO.
 // \:::
 // \prg_do_nothing:
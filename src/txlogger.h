@@ -193,6 +193,7 @@ auto operator<<(FullLogger &X, const Xml *s) -> FullLogger &;
 auto operator<<(HalfLogger &X, String s) -> HalfLogger &;
 auto operator<<(HalfLogger &X, Istring s) -> HalfLogger &;
 auto operator<<(HalfLogger &X, int s) -> HalfLogger &;
+auto operator<<(HalfLogger &X, size_t s) -> HalfLogger &;
 auto operator<<(HalfLogger &X, const std::string &s) -> HalfLogger &;
 
 extern Logger &   the_log;
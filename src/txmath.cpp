@@ -784,6 +784,7 @@ auto Parser::is_inner_math() -> bool { return cmi.is_inline(); }
 // Toplevel function. Reads and translates a formula.
 // Argument as in start_scan_math
 void Parser::T_math(subtypes type) {
+    math_data.need_xml();
     auto nm = eqtb_int_table[nomath_code].val;
     cmi.reset(nm == -3);
     Trace.reset();
@@ -1179,7 +1180,7 @@ void Parser::scan_math(int res, math_list_type type) {
 // We have seen & or \\. Possibly inserts v-part
 auto Parser::scan_math_endcell(Token t) -> bool {
     if (the_stack.is_frame(np_cell) && !the_stack.is_omit_cell()) {
-        TokenList L = the_stack.get_u_or_v(false);
+        auto L = the_stack.get_u_or_v(false);
         if (!L.empty()) {
             if (tracing_commands()) the_log << lg_startbrace << "template v-part " << L << lg_endbrace;
             back_input(t);
@@ -1365,7 +1366,7 @@ auto Parser::scan_math_env(int res, math_list_type type) -> bool {
     // Check if v-part of template has to be inserted here
     if (!at_start && stack_math_in_cell()) {
         if (the_stack.is_frame(np_cell) && !the_stack.is_omit_cell()) {
-            TokenList L = the_stack.get_u_or_v(false);
+            auto L = the_stack.get_u_or_v(false);
             if (!L.empty()) {
                 if (tracing_commands()) the_log << lg_startbrace << "template v-part " << L << lg_endbrace;
                 back_input(cur_tok);
@@ -109,9 +109,9 @@ private:
     [[nodiscard]] auto is_accent() const -> bool { return val.is_mathml() && Font == 0; }
 };
 
-using MathList            = std::list<MathElt>;
-using const_math_iterator = std::list<MathElt>::const_iterator;
-using math_iterator       = std::list<MathElt>::iterator;
+using MathList            = std::list<MathElt, PoolAllocator<MathElt>>;
+using const_math_iterator = MathList::const_iterator;
+using math_iterator       = MathList::iterator;
 
 class Math {
     friend class MathHelper;
@@ -316,7 +316,17 @@ private:
 
 // This is a global object for math handling
 class MathDataP {
-    static const int m_offset = 10000;
+    static const int m_offset       = 10000;
+    static const int boot_fixed_xid = 527; // number of elements created by boot_xml, other than by mk_xml
+
+    // A command defined by mk_gen or mk_moo; its value is built by boot_xml
+    struct MathSymbol {
+        String         ent, ent2;
+        math_loc       pos, pos2; // pos2 is the bold variant, if not pos
+        name_positions bl;
+        bool           hack, prefix;
+    };
+
     Xml *            built_in_table[last_math_loc]{};     // the static math table
     Xml *            built_in_table_alt[last_math_loc]{}; // the static math table
     Xml **           xml_math_table{};                    // the dynamic math table
@@ -333,8 +343,14 @@ class MathDataP {
     bool       no_ent_names{};
     Token      nomathsw0; // says next token is for nomathml only
     Token      nomathsw1; // says next token is for normal mode only
+
+    std::vector<MathSymbol> symbols;       // commands whose value is not yet built
+    long                    boot_xid{};    // first element id reserved for boot_xml
+    long                    boot_nb_xid{}; // number of element ids reserved for boot_xml
+    bool                    xml_booted{};  // true if boot_xml has been called
 private:
     void boot_table();
+    void boot_xml();
     void boot2();
     void boot_chars();
     void boot_xml_lr_tables();
@@ -352,10 +368,14 @@ private:
     void mk_accent(String name, String ent, String ent2, subtypes pos);
     void fill_lr(int a, String b, String c);
     void fill_lr(int a, String b);
-    auto init_builtin(String name, math_loc pos, Xml *x, symcodes t) -> Token;
+    auto mk_builtin(String name, math_loc pos, symcodes t) -> Token;
+    void mk_xml(const MathSymbol &S);
 
 public:
     void        boot();
+    void        need_xml() {
+        if (!xml_booted) boot_xml();
+    }
     void        realloc_list0();
     void        realloc_list();
     void        realloc_xml();
@@ -1249,47 +1249,54 @@ auto math_ns::math_constants(int c) -> Xml * {
     return math_data.get_mc_table(0);
 }
 
-auto MathDataP::init_builtin(String name, math_loc pos, Xml *x, symcodes t) -> Token {
-    init_builtin(pos, x);
-    return the_parser.hash_table.primitive(name, t, subtypes(pos));
-}
+// Defines name to be (t,pos); the value at math-location pos
+// is put in the table by boot_xml.
+auto MathDataP::mk_builtin(String name, math_loc pos, symcodes t) -> Token { return the_parser.hash_table.primitive(name, t, subtypes(pos)); }
 
 // This is for a general token. It defines name to be (t,pos)
-// It adds defined math-location pos to be <bl>ent</bl>
+// It remembers that math-location pos is <bl>ent</bl>, see mk_xml.
 // If hack is true, the formula $\name$ can be hacked to ent (i.e.
 // $\alpha$ translates to &alpha;) If no entity names are desired
 // then ent2 is used instead of ent, so that \alpha gives &#x3B1;
 
 auto MathDataP::mk_gen(String name, String ent, String ent2, math_loc pos, name_positions bl, symcodes t, bool hack) -> Token {
-    Xml *x = new Xml(Istring(no_ent_names ? ent2 : ent));
-    if (hack) built_in_table_alt[pos] = x;
-    x = new Xml(bl, x);
-    return init_builtin(name, pos, x, t);
+    symbols.push_back({ent, ent2, pos, pos, bl, hack, false});
+    return mk_builtin(name, pos, t);
 }
 
 // Special case where a bold variant exists
 auto MathDataP::mk_gen(String name, String ent, String ent2, math_loc pos, math_loc pos2, name_positions bl, symcodes t, bool hack)
     -> Token {
-    Xml *x = new Xml(Istring(no_ent_names ? ent2 : ent));
-    if (hack) built_in_table_alt[pos] = x;
-    Xml *bold = new Xml(bl, x);
-    bold->add_att(cst_mathvariant, cstf_bold);
-    init_builtin(pos2, bold);
-    x = new Xml(bl, x);
-    return init_builtin(name, pos, x, t);
+    symbols.push_back({ent, ent2, pos, pos2, bl, hack, false});
+    return mk_builtin(name, pos, t);
 }
 
 // This defines name to be a math ord command.
 // the value is <mo>ent</mo> , with form=prefix, movable_limits = maybe
 void MathDataP::mk_moo(String name, String ent, math_loc pos) {
-    Xml *x = mk_mo(ent);
-    x->add_att(np_form, np_prefix);
+    symbols.push_back({ent, ent, pos, pos, cst_mo, false, true});
     symcodes T = mathopn_cmd;
-    if (first_w_limit_code <= pos && pos <= last_w_limit_code) {
-        T = mathop_cmd;
-        x->add_att(np_movablelimits, np_true);
+    if (first_w_limit_code <= pos && pos <= last_w_limit_code) T = mathop_cmd;
+    mk_builtin(name, pos, T);
+}
+
+// Builds the value of a command defined by mk_gen or mk_moo.
+void MathDataP::mk_xml(const MathSymbol &S) {
+    if (S.prefix) {
+        Xml *x = mk_mo(S.ent);
+        x->add_att(np_form, np_prefix);
+        if (first_w_limit_code <= S.pos && S.pos <= last_w_limit_code) x->add_att(np_movablelimits, np_true);
+        init_builtin(S.pos, x);
+        return;
     }
-    init_builtin(name, pos, x, T);
+    Xml *x = new Xml(Istring(no_ent_names ? S.ent2 : S.ent));
+    if (S.hack) built_in_table_alt[S.pos] = x;
+    if (S.pos2 != S.pos) {
+        Xml *bold = new Xml(S.bl, x);
+        bold->add_att(cst_mathvariant, cstf_bold);
+        init_builtin(S.pos2, bold);
+    }
+    init_builtin(S.pos, new Xml(S.bl, x));
 }
 
 // This associates to the command name, a <mi> element with value ent/ent2
@@ -1330,7 +1337,8 @@ void MathDataP::mk_accent(String name, String ent, String ent2, subtypes pos) {
 // is defined to be <mo> with value b.
 void MathDataP::TM_mk(String a, String b, math_types c) {
     auto A = uchar(a[0]);
-    init_builtin(A + math_c_loc, mk_mo(b));
+    auto k = math_loc(A + math_c_loc);
+    symbols.push_back({b, b, k, k, cst_mo, false, false});
     math_char_type[A] = c;
 }
 
@@ -1469,31 +1477,30 @@ void MathDataP::boot2() {
     // Define \colon
     Xml *colon = mk_mo(":");
     colon->add_att(Istring("lspace"), Istring("0pt"));
-    init_builtin("colon", colon_code, colon, mathord_cmd);
+    init_builtin(colon_code, colon);
     // Constructs varlim etc
 
     Xml *lim_op = mk_mo("lim");
     lim_op->add_att(np_movablelimits, np_false);
     Xml *x = xml2sons(Istring(cst_mover), lim_op, get_mc_table(1));
-    init_builtin("varlimsup", varlimsup_code, x, mathop_cmd);
+    init_builtin(varlimsup_code, x);
 
     x = xml2sons(Istring(cst_munder), lim_op, get_mc_table(3));
-    init_builtin("varliminf", varliminf_code, x, mathop_cmd);
+    init_builtin(varliminf_code, x);
 
     x = xml2sons(Istring(cst_munder), lim_op, get_builtin(underrightarrow_code));
     x->add_att(cst_accentunder, np_true);
-    init_builtin("varinjlim", varinjlim_code, x, mathop_cmd);
+    init_builtin(varinjlim_code, x);
 
     x = xml2sons(Istring(cst_munder), lim_op, get_builtin(underleftarrow_code));
     x->add_att(cst_accentunder, np_true);
-    init_builtin("varprojlim", varprojlim_code, x, mathop_cmd);
+    init_builtin(varprojlim_code, x);
 
     x = mk_mo("(");
     x = new Xml(Istring(cst_mpadded), x);
     x->add_att(np_cst_width, np_zerodim);
     x = new Xml(Istring(cst_mphantom), x);
-    init_builtin("strut", strut_code, x, mathord_cmd);
-    init_builtin("mathstrut", strut_code, x, mathord_cmd);
+    init_builtin(strut_code, x);
 
     Xml *y = new Xml(Istring(cst_mpadded), get_builtin(int_code));
     y->add_att(Istring(np_cst_width), Istring("-3pt"));
@@ -1503,14 +1510,14 @@ void MathDataP::boot2() {
     x->push_back(y);
     x->push_back(y);
     x->push_back(z);
-    init_builtin("iint", iint_code, x, mathop_cmd);
+    init_builtin(iint_code, x);
     x = new Xml(cst_mrow, nullptr);
     x->push_back(z);
     x->push_back(y);
     x->push_back(y);
     x->push_back(y);
     x->push_back(z);
-    init_builtin("iiint", iiint_code, x, mathop_cmd);
+    init_builtin(iiint_code, x);
     x = new Xml(cst_mrow, nullptr);
     x->push_back(z);
     x->push_back(y);
@@ -1518,27 +1525,23 @@ void MathDataP::boot2() {
     x->push_back(y);
     x->push_back(y);
     x->push_back(z);
-    init_builtin("iiiint", iiiint_code, x, mathop_cmd);
+    init_builtin(iiiint_code, x);
     x = new Xml(cst_mrow, nullptr);
     x->push_back(get_builtin(int_code));
     x->push_back(math_data.get_mc_table(6));
     x->push_back(get_builtin(int_code));
-    init_builtin("idotsint", idotsint_code, x, mathop_cmd);
-    x                                         = new Xml(Istring("none"), nullptr);
-    the_parser.hash_table.mmlnone_token       = init_builtin("mmlnone", mml_none_code, x, mathord_cmd);
-    x                                         = new Xml(Istring("mprescripts"), nullptr);
-    the_parser.hash_table.mmlprescripts_token = init_builtin("mmlprescripts", mml_prescripts_code, x, mathord_cmd);
+    init_builtin(idotsint_code, x);
+    init_builtin(mml_none_code, new Xml(Istring("none"), nullptr));
+    init_builtin(mml_prescripts_code, new Xml(Istring("mprescripts"), nullptr));
 }
 
+// This defines all math commands. Their values are built by boot_xml,
+// on the first formula; the element ids it needs are reserved here,
+// so that ids in the document do not depend on it.
 void MathDataP::boot() {
     no_ent_names = the_main->no_entnames;
-    for (auto &i : built_in_table) i = nullptr;
-    for (auto &i : built_in_table_alt) i = nullptr;
     boot_table();
-    fill_single_char();
-    fill_math_char_slots();
-    if (!no_ent_names) fill_math_char_slots_ent();
-    boot_chars();
+    symbols.reserve(640);
 
     mk_icb("alpha", "&alpha;", "&#x3B1;", alpha_code);
     mk_icb("beta", "&beta;", "&#x3B2;", beta_code);
@@ -2079,7 +2082,6 @@ void MathDataP::boot() {
     the_parser.hash_table.math_CB_token = mk_gen("math}", "}", "}", close_brace_code, cst_mo, mathclose_cmd, true);
     // mk_oc("varprime", "&prime;","&#x02032;", prime_code);
     mk_oc("prime", "&apos;", "&#x27;", prime_code);
-    mc_table[27] = built_in_table[prime_code];
 
     TM_mk("<", "&lt;", mt_flag_small);
     TM_mk(">", "&gt;", mt_flag_small);
@@ -2199,6 +2201,43 @@ void MathDataP::boot() {
     mk_cmd("smash", smash_code);
     mk_cmd("accentset", accentset_code);
     mk_cmd("underaccent", underaccent_code);
+    mk_space(">", xml_medmu_space_loc);
+    mk_space(";", xml_thickmu_space_loc);
+    mk_space(":", xml_medmu_space_loc);
+
+    // Commands built by boot2
+    mk_builtin("colon", colon_code, mathord_cmd);
+    mk_builtin("varlimsup", varlimsup_code, mathop_cmd);
+    mk_builtin("varliminf", varliminf_code, mathop_cmd);
+    mk_builtin("varinjlim", varinjlim_code, mathop_cmd);
+    mk_builtin("varprojlim", varprojlim_code, mathop_cmd);
+    mk_builtin("strut", strut_code, mathord_cmd);
+    mk_builtin("mathstrut", strut_code, mathord_cmd);
+    mk_builtin("iint", iint_code, mathop_cmd);
+    mk_builtin("iiint", iiint_code, mathop_cmd);
+    mk_builtin("iiiint", iiiint_code, mathop_cmd);
+    mk_builtin("idotsint", idotsint_code, mathop_cmd);
+    the_parser.hash_table.mmlnone_token       = mk_builtin("mmlnone", mml_none_code, mathord_cmd);
+    the_parser.hash_table.mmlprescripts_token = mk_builtin("mmlprescripts", mml_prescripts_code, mathord_cmd);
+    boot_nb_xid = boot_fixed_xid;
+    for (const auto &x : symbols) boot_nb_xid += (x.prefix || x.pos2 == x.pos) ? 1 : 2;
+    boot_xid = the_parser.the_stack.reserve_xids(boot_nb_xid);
+}
+
+// Builds the values of the math commands, and the other math tables.
+void MathDataP::boot_xml() {
+    xml_booted = true;
+    auto &S    = the_parser.the_stack;
+    auto  last = S.get_xid().value;
+    S.use_reserved_xids(boot_xid, boot_nb_xid);
+    fill_single_char();
+    fill_math_char_slots();
+    if (!no_ent_names) fill_math_char_slots_ent();
+    boot_chars();
+    for (const auto &x : symbols) mk_xml(x);
+    symbols.clear();
+    mc_table[27] = built_in_table[prime_code];
+
     init_builtin(xml_zero_space_loc, mk_space("0.3pt"));
     init_builtin(xml_thinmu_space_loc, mk_space("0.166667em"));
     init_builtin(xml_medmu_space_loc, mk_space("0.222222em"));
@@ -2208,13 +2247,11 @@ void MathDataP::boot() {
     init_builtin(xml_quad_space_loc, mk_space("3.33333pt"));
     //  mk_space("enspace", xml_thinmu_space_loc);
     // mk_space("zerospace", xml_zero_space_loc);
-    mk_space(">", xml_medmu_space_loc);
-    mk_space(";", xml_thickmu_space_loc);
-    mk_space(":", xml_medmu_space_loc);
     init_builtin(math_c_loc + '~', xml_quad_space_loc);
     math_char_type[uchar('~')] = mt_flag_space;
     boot_xml_lr_tables();
     boot2();
+    if (S.end_reserved_xids() != 0 || S.get_xid().value != last) err_ns::fatal_error("bad number of ids reserved for math");
 }
 
 // 338 (big ) 337 (small) negation postfix
@@ -315,47 +315,58 @@ auto Parser::scan_group_del1(TokenList &res, Token x) -> bool {
 }
 
 // reads a token list R followed by L (which is discarded).
-// At every stage we check that L is present; if not so, a token or a group is read
-// outer braces are removed if possible.
-auto Parser::scan_group_del(TokenList &res, const TokenList &L) -> bool {
-    int cl = get_cur_line();
-    int b  = -1;
+// Outer braces are removed if possible. The tokens that match a prefix of L
+// are kept in a list; in case of mismatch, F (the failure function of L)
+// says how many of them are contributed to R (as a single token each, in
+// the same way as by scan_group1), so that no token is read twice. If the
+// current token does not match L at all, a token or a group is read.
+auto Parser::scan_group_del(TokenList &res, TokenSpan L, const uint32_t *F) -> bool {
+    int       cl = get_cur_line();
+    int       b  = -1;
+    auto      n  = L.size();
+    TokenList matched;
     for (;;) {
-        // First check if L is found
-        TokenList backup;
-        auto      C = L.begin();
-        auto      E = L.end();
-        for (;;) {
-            if (C == E) { // ok found
-                if (b == 0) {
-                    res.pop_back();
-                    res.pop_front();
-                }
-                return false;
+        auto j = matched.size();
+        if (j == n) { // ok found
+            if (b == 0) {
+                res.pop_back();
+                res.pop_front();
             }
-            Token x = *C;
-            ++C;
-            if (get_token()) { // EOF abort
-                bad_delimited(cl, Token(0));
-                return true;
-            }
-            backup.push_back(cur_tok);
-            if (x.is_same_token(cur_tok)) continue;
-            back_input(backup);
-            break;
+            return false;
         }
-        if (get_token()) {
+        if (get_token()) { // EOF abort
             bad_delimited(cl, Token(0));
             return true;
         }
-        if (scan_group1(res, b, cl)) return true;
+        for (;;) {
+            if (L.begin()[j].is_same_token(cur_tok)) {
+                matched.push_back(cur_tok);
+                break;
+            }
+            if (j == 0) {
+                if (scan_group1(res, b, cl)) return true;
+                break;
+            }
+            Token cur = cur_tok;
+            for (auto k = j - F[j - 1]; k > 0; k--) {
+                cur_tok = matched.front();
+                matched.pop_front();
+                if (scan_group1(res, b, cl)) {
+                    back_input(cur);
+                    back_input(matched);
+                    return true;
+                }
+            }
+            cur_tok = cur;
+            j       = matched.size();
+        }
     }
 }
 
 // Reads the tokens of the list L
 // in the case below, a closing brace is inserted so that no runaway is signaled.
 // \def\tfoo a{} \edef\xx{\tfoo}
-auto Parser::skip_prefix(const TokenList &L) -> bool {
+auto Parser::skip_prefix(TokenSpan L) -> bool {
     auto C = L.begin();
     auto E = L.end();
     while (C != E) {
@@ -509,9 +520,11 @@ void Parser::ignore_arg() {
 // given the token list foo as argument.
 // NOTE. used only in \for loops and result ignored.
 auto Parser::read_delimited(const TokenList &L) -> TokenList {
-    TokenList res;
+    TokenList             res;
+    std::vector<uint32_t> F(L.size());
+    token_ns::failure_function(L, F.data());
     scanner_status = ss_matching;
-    scan_group_del(res, L);
+    scan_group_del(res, L, F.data());
     scanner_status = ss_normal;
     return res;
 }
@@ -1107,18 +1120,19 @@ auto Parser::read_mac_nbargs() -> size_t {
     return 0;
 }
 
-// scans the `#1#2foo' part of \def\bar#1#2foo{}
-void Parser::get_def_nbargs(Macro *X, Token name) {
+// scans the `#1#2foo' part of \def\bar#1#2foo{}; the delimiters are put in D,
+// the number of arguments in nb, and the type of the macro is returned
+auto Parser::get_def_nbargs(std::array<TokenList, 10> &D, size_t &nb, Token name) -> def_type {
     def_type  code = dt_normal;
-    size_t    nb   = 0;
     TokenList L;
+    nb             = 0;
     scanner_status = ss_defining;
     for (;;) {
         if (get_token()) break; // will signal an error later
         if (cur_cmd_chr.is_parameter()) {
             if (get_token()) break;
             if (cur_cmd_chr.is_other() && cur_cmd_chr.chr == nb + '1') {
-                X->set_delimiters(nb, L);
+                D[nb].swap(L);
                 L.clear();
                 nb++;
             } else if (cur_cmd_chr.is_open_brace()) {
@@ -1141,19 +1155,18 @@ void Parser::get_def_nbargs(Macro *X, Token name) {
         L.push_back(cur_tok);
     }
     scanner_status = ss_normal;
-    X->set_delimiters(nb, L);
-    X->set_nbargs(nb);
-    X->set_type(code);
+    D[nb].swap(L);
+    return code;
 }
 
 // Changes the type of a trivial macro.
 void Macro::correct_type() {
     if (type == dt_empty) type = dt_normal; // Is this needed ?
-    if (type == dt_normal && body.empty() && nbargs == 0) type = dt_empty;
+    if (type == dt_normal && body().empty() && nbargs == 0) type = dt_empty;
     if (type == dt_optional && nbargs > 1) {
-        const TokenList &L = delimiters[1];
-        auto             A = L.begin();
-        auto             B = L.end();
+        auto L = (*this)[1];
+        auto A = L.begin();
+        auto B = L.end();
         if (A == B) return;
         if (*A != the_parser.hash_table.dblarg_token) return;
         ++A;
@@ -1167,13 +1180,16 @@ void Parser::M_def(bool edef, bool gbl, symcodes what, rd_flag fl) {
     skip_initial_space();
     Token name = cur_tok;
     if (cur_tok.not_a_cmd()) bad_redefinition(2, name);
-    auto *X = new Macro;
+    Macro *X = nullptr;
     {
-        SaveErrTok sv(name);
-        get_def_nbargs(X, name);
+        SaveErrTok                sv(name);
+        std::array<TokenList, 10> D;
+        TokenList                 body;
+        size_t                    nb   = 0;
+        def_type                  code = get_def_nbargs(D, nb, name);
         back_input();
-        read_mac_body(X->body, edef, X->nbargs);
-        X->correct_type();
+        read_mac_body(body, edef, nb);
+        X = new Macro(nb, code, D.data(), body);
     }
     mac_define(name, X, gbl, fl, what);
 }
@@ -1185,13 +1201,12 @@ void Parser::M_declare_math_operator() {
     bool  see_star = remove_initial_star();
     Token name     = get_r_token(true);
     if (tracing_commands()) the_log << lg_startbracebs << "DeclareMathOperator " << name << lg_endbrace;
-    auto *     X = new Macro;
-    TokenList &L = X->body;
+    TokenList L;
     read_mac_body(L, false, 0);
     brace_me(L);
     if (see_star) L.push_front(hash_table.star_token);
     L.push_front(hash_table.operatorname_token);
-    mac_define(name, X, true, rd_if_undef, user_cmd);
+    mac_define(name, new Macro(L), true, rd_if_undef, user_cmd);
 }
 
 // \newtheorem{name}{text}[c]    case 1
@@ -1416,7 +1431,7 @@ void Parser::expand_mac(Macro &X) {
     for (size_t i = 1; i <= n; i++) {
         if (spec == dt_delim || spec == dt_brace) {
             if (!X[i].empty()) {
-                if (scan_group_del(arguments[i], X[i])) return;
+                if (scan_group_del(arguments[i], X[i], X.failure(i))) return;
             } else if (scan_group2(arguments[i]))
                 return;
         } else if (!optional) {
@@ -1434,43 +1449,42 @@ void Parser::expand_mac(Macro &X) {
                     i++;
                     arguments[2] = arguments[1];
                 } else
-                    arguments[1] = X[1];
+                    arguments[1] = X[1].to_list();
             }
         }
         if (tracing_macros()) the_log << "#" << i << "<-" << arguments[i] << lg_end;
     }
-    TokenList res = expand_mac_inner(X.body, arguments);
-    if (spec == dt_brace) res.push_back(hash_table.OB_token);
-    back_input(res);
-}
-
-// This is the code that replaces arguments by values in the body.
-// note that Tex uses a completely different method (there is a stack with
-// all arguments of all macros; here we have just one table).
-auto Parser::expand_mac_inner(const TokenList &W, TokenList *arguments) -> TokenList {
-    auto      C = W.begin();
-    auto      E = W.end();
-    TokenList res;
-    while (C != E) {
-        Token x = *C;
-        ++C;
-        if (x.is_a_char() && x.cmd_val() == eol_catcode) {
-            int       k  = x.chr_val();
-            TokenList ww = arguments[k];
-            res.splice(res.end(), ww);
+    if (spec == dt_brace) back_input(hash_table.OB_token);
+    expand_mac_inner(X.body(), arguments, TL);
+}
+
+// This is the code that replaces arguments by values in the body; the result
+// is inserted in front of L. Note that TeX uses a completely different method
+// (there is a stack with all arguments of all macros, and the body is read in
+// place). Here the size of the result is computed first, and each token of
+// the body and of the arguments is copied once, directly to its final place.
+void Parser::expand_mac_inner(TokenSpan W, TokenList *arguments, TokenList &L) {
+    size_t n = 0;
+    for (auto x : W) n += x.is_out_param() ? arguments[x.chr_val()].size() : 1;
+    auto p = L.grow_front(n);
+    for (auto x : W) {
+        if (x.is_out_param()) {
+            const auto &A = arguments[x.chr_val()];
+            p             = std::copy(A.begin(), A.end(), p);
         } else
-            res.push_back(x);
+            *p++ = x;
     }
-    return res;
 }
 
 // -------------------
 // Converting a list of token into a string or a CS name
 
 // returns true if bad; fills the buffer b until finding \endcsname
+// Character tokens are not expandable, so that get_x_char_token can take
+// them directly from TL or from the current line.
 auto Parser::list_to_string0(Buffer &b) -> bool {
     for (;;) {
-        if (get_x_token()) return true;
+        if (get_x_char_token()) return true;
         if (cur_cmd_chr.cmd == endcsname_cmd) return false;
         if (cur_tok.not_a_cmd()) {
             b.push_back(cur_cmd_chr.char_val());
@@ -1826,8 +1840,8 @@ void Parser::counter_boot(String s, String aux) {
 // otherwise, checks that \c@foo is undefined or relax
 // Returns true if bad
 auto Parser::counter_check(Buffer &b, bool def) -> bool {
-    cur_tok       = hash_table.locate(b);
-    Equivalent &E = hash_table.eqtb[cur_tok.eqtb_loc()];
+    cur_tok      = hash_table.locate(b);
+    Equivalent E = hash_table.eqtb[cur_tok.eqtb_loc()];
     if (def) {
         if (!E.is_undef_or_relax()) {
             bad_redefinition(0, cur_tok);
@@ -2168,8 +2182,8 @@ auto Parser::find_env_token(const std::string &name, bool beg) -> Token {
     return cur_tok;
 }
 
-// Hack for \begin{foo}
-auto Parser::env_helper(const std::string &s) -> SaveAuxEnv * {
+// Hack for \begin{foo}; this opens the group of the environment
+void Parser::env_helper(const std::string &s) {
     int cl = get_cur_line();
     find_env_token(s, true);
     std::string cur_e_name = get_cur_env_name();
@@ -2180,23 +2194,16 @@ auto Parser::env_helper(const std::string &s) -> SaveAuxEnv * {
     find_env_token(s, false);
     Token t = cur_tok;
     if (cur_cmd_chr.is_undef()) cur_cmd_chr = CmdChr(relax_cmd, relax_code);
-    return new SaveAuxEnv(cur_e_name, s, cl, t, cur_cmd_chr);
+    push_level(bt_env);
+    push_save_env(cur_e_name, s, cl, t, cur_cmd_chr);
 }
 
 // This implements \begin{foo}
 void Parser::T_begin(const std::string &s) {
-    SaveAuxEnv *X = env_helper(s);
-    push_level(bt_env);
-    push_save_stack(X);
+    env_helper(s);
     set_cur_env_name(s);
 }
 
-// This is executed when we pop a slot containing restore-foo-env
-void SaveAuxEnv::unsave(bool trace, Parser &P) {
-    if (trace) the_log << lg_startstack << "ending environment " << name << "; resuming " << oldname << ".\n";
-    P.set_cur_env_name(oldname, line);
-}
-
 // This is the code of \end{foo}.
 void Parser::T_end(const std::string &s) {
     if (s == "document") // hack, because document is at outer level
@@ -2211,7 +2218,7 @@ void Parser::T_end(const std::string &s) {
         parse_error(err_tok, "Illegal \\end{}");
         return;
     }
-    SaveAuxEnv *X = is_env_on_stack(s);
+    SaveAux *X = is_env_on_stack(s);
     if (X == nullptr) {
         parse_error(err_tok, "cannot close environment ", s, "bad \\end");
         return;
@@ -2223,11 +2230,13 @@ void Parser::T_end(const std::string &s) {
         cur_level++;
         throw EndOfData();
     }
-    back_input(X->token);
+    Token  E  = X->env_val.token;
+    CmdChr cc = X->env_val.cc;
+    back_input(E);
     back_input(hash_table.sendgroup_token);
-    cur_tok = X->token;
-    if (X->cc.is_user()) {
-        cur_cmd_chr = X->cc;
+    cur_tok = E;
+    if (cc.is_user()) {
+        cur_cmd_chr = cc;
         Macro &T    = mac_table.get_macro(cur_cmd_chr.chr);
         if (T.nbargs != 0)
             parse_error(err_tok, "Illegal end of environment");
@@ -2236,7 +2245,7 @@ void Parser::T_end(const std::string &s) {
     } else {
         Token t = hash_table.temp_token;
         auto  k = t.eqtb_loc();
-        hash_table.eqtb[k].setnl(X->cc);
+        hash_table.eqtb[k].setnl(cc);
         back_input(t);
     }
 }
@@ -2274,7 +2283,7 @@ auto Parser::get_mac_value(Token t) -> TokenList {
     Macro &  M = mac_table.get_macro(c);
     if (M.type != dt_normal) return res;
     if (M.nbargs != 0) return res;
-    return M.body;
+    return M.body().to_list();
 }
 
 // c is the number of arguments, c=0 is the same as 1, 5 is 12of3
@@ -2575,7 +2584,7 @@ auto Parser::scan_keyword(String s) -> bool {
     TokenList L;
     for (;;) {
         if (s[k] == 0) return true;
-        get_x_token();
+        get_x_char_token();
         if (cur_tok.not_a_cmd() && (cur_cmd_chr.char_val() == uchar(s[k]) || cur_cmd_chr.char_val() == uchar(s[k] + 'A' - 'a'))) {
             L.push_back(cur_tok);
             k++;
@@ -3009,6 +3018,7 @@ auto Parser::E_ifx() -> bool {
     if (tracing_commands()) the_log << "\\ifx compares " << a << b << "\n";
     if (cur_cmd_chr.cmd != pq.cmd) return false;
     if (cur_cmd_chr.is_user()) {
+        if (cur_cmd_chr.chr == pq.chr) return true; // identical macros share a slot
         Macro &A = mac_table.get_macro(cur_cmd_chr.chr);
         Macro &B = mac_table.get_macro(pq.chr);
         return A.is_same(B);
@@ -3227,27 +3237,23 @@ void Parser::M_new_env(rd_flag redef) {
     }
     mac_define(T, X, false, redef, what);
     T = find_env_token(name, false);
-    X = new Macro;
     {
         SaveErrTok sv(T);
-        read_mac_body(X->body, false, 0);
-        X->correct_type();
+        TokenList  body;
+        read_mac_body(body, false, 0);
+        X = new Macro(body);
     }
     mac_define(T, X, false, redef, what);
 }
 
 // Common code for \newcommand and \newenv, constructs the macro
 auto Parser::read_latex_macro() -> Macro * {
-    auto *X = new Macro;
-    auto  n = read_mac_nbargs();
-    X->set_nbargs(n);
-    TokenList op_arg;
-    bool      have_op_arg = read_optarg(op_arg);
-    X->set_delimiters(1, op_arg);
-    X->set_type(have_op_arg ? dt_optional : dt_normal);
-    read_mac_body(X->body, false, n);
-    X->correct_type();
-    return X;
+    auto                      n = read_mac_nbargs();
+    std::array<TokenList, 10> D;
+    bool                      have_op_arg = read_optarg(D[1]);
+    TokenList                 body;
+    read_mac_body(body, false, n);
+    return new Macro(n, have_op_arg ? dt_optional : dt_normal, D.data(), body);
 }
 
 // \def, \xdef, \gdef, \edef, latex variants and latex3 variants
@@ -4208,9 +4214,8 @@ void Parser::begin_box(size_t src, subtypes c) {
         }
         back_input(L);
     }
-    Xml *    cur_boxa = the_stack.push_hbox(box_name);
-    SaveAux *x        = new SaveAuxBoxend(src, cur_boxa);
-    push_save_stack(x);
+    Xml *cur_boxa = the_stack.push_hbox(box_name);
+    push_save_stack(SaveAux::boxend_entry(src, cur_boxa));
     the_stack.set_arg_mode();
 }
 
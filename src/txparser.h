@@ -33,7 +33,9 @@ public:
     Mactab                                    mac_table;          // the table of macros
     Stack                                     the_stack;          // the stack
     std::array<EqtbString, 10>                eqtb_string_table;  // eqtb strings
-    std::array<EqtbInt, integer_table_size>   eqtb_int_table;     // EQTB, integers
+    EqtbIntTable<integer_table_size>          eqtb_int_table;     // EQTB, integers
+    std::vector<CatcodeTable *>               catcode_tables;     // \initcatcodetable (0 is in eqtb_int_table)
+    EqtbInt *                                 catcodes;           // the current catcode table
     std::array<EqtbDim, dimension_table_size> eqtb_dim_table;     // EQTB, dimensions
     std::array<EqtbToken, toks_register_size> toks_registers;     // EQTB, token lists
     std::array<EqtbBox, nb_registers>         box_table;          // EQTB, boxes
@@ -102,8 +104,8 @@ private:
 private:
     auto               at_eol() -> bool { return input_line_pos >= input_line.size(); }
     auto               get_next_char() -> codepoint { return input_line[input_line_pos++]; }
-    [[nodiscard]] auto get_catcode(size_t x) const -> symcodes { return symcodes(eqtb_int_table[x].val); }
-    void               set_catcode(size_t x, long v) { eqtb_int_table[x].val = v; }
+    [[nodiscard]] auto get_catcode(size_t x) const -> symcodes { return symcodes(catcodes[x].val); }
+    void               set_catcode(size_t x, long v) { catcodes[x].val = v; }
     auto               get_after_ass_tok() -> Token {
         Token x = after_assignment_token;
         after_assignment_token.kill();
@@ -124,7 +126,7 @@ private:
         cur_cmd_chr.chr = t.chr_val();
     }
     void               set_after_ass_tok(Token x) { after_assignment_token = x; }
-    void               set_cat(size_t c, int v) { eqtb_int_table[c].val = v; }
+    void               set_cat(size_t c, int v) { catcodes[c].val = v; }
     void               set_def_language_num(int x) { default_language_num = x; }
     [[nodiscard]] auto tracing_io() const -> bool { return is_pos_par(tracingoutput_code); }
     [[nodiscard]] auto tracing_macros() const -> bool { return is_pos_par(tracingmacros_code); }
@@ -135,6 +137,7 @@ public:
     void               back_input() { TL.push_front(cur_tok); }
     void               back_input(Token t) { TL.push_front(t); }
     void               back_input(TokenList &L) { TL.splice(TL.begin(), L); }
+    void               back_input(const SharedTokenList &L) { TL.insert(TL.begin(), L.begin(), L.end()); }
     void               brace_me(TokenList &L);
     [[nodiscard]] auto cur_centering() const -> long { return eqtb_int_table[incentering_code].val; }
     [[nodiscard]] auto cur_lang_fr() const -> bool { return eqtb_int_table[language_code].val == 1; }
@@ -182,6 +185,7 @@ public:
     void               boot();
     void               boot_special_names();
     void               box_end(Xml *res, size_t pos);
+    auto               catcode_table(size_t k) -> EqtbInt *;
     auto               list_to_string0(Buffer &b) -> bool;
     auto               list_to_string(TokenList &L, Buffer &b) -> bool;
     auto               list_to_string_cv(TokenList &L, Buffer &b) -> bool;
@@ -240,7 +244,7 @@ public:
     void               translate_all();
     void               word_define(size_t a, long c, bool gbl);
     auto               find_a_save_key(const std::string &mykey) -> bool;
-    static auto        expand_mac_inner(const TokenList &W, TokenList *arguments) -> TokenList;
+    static void        expand_mac_inner(TokenSpan W, TokenList *arguments, TokenList &L);
     void               mu_error(String s, int i);
     void               expand_nct(TokenList &L);
     void               token_for_show(const CmdChr &val);
@@ -303,6 +307,7 @@ private:
     void        calc_spec_mul(RealNumber val, SthInternal &res);
     void        call_define_key(TokenList &L, Token cmd, const std::string &arg, const std::string &fam);
     void        T_case_shift(int c);
+    void        T_catcode_table(subtypes c);
     static void check_all_ids();
     auto        check_brace(int &b) -> bool;
     auto        check_builtin_pack(const std::string &pack) -> bool;
@@ -349,7 +354,7 @@ private:
     auto        edef_aux(TokenList &L) -> bool;
     void        english_quotes(CmdChr X);
     void        enter_file_in_table(const std::string &nm, bool ok);
-    auto        env_helper(const std::string &s) -> SaveAuxEnv *;
+    void        env_helper(const std::string &s);
     void        examine_token(Token T);
     void        exec_calc();
     void        exec_fp_cmd(subtypes i);
@@ -444,7 +449,7 @@ private:
     void        get_counter(Token T, long &c);
     auto        get_index_value() -> size_t;
     void        get_date_ctrs(long &year, long &month, long &day);
-    void        get_def_nbargs(Macro *X, Token name);
+    auto        get_def_nbargs(std::array<TokenList, 10> &D, size_t &nb, Token name) -> def_type;
     auto        get_lrcs_opt() -> name_positions;
     auto        cs_from_input() -> Token;
     auto        get_mac_value(Token T) -> TokenList;
@@ -460,6 +465,7 @@ private:
     auto        get_token_o() -> bool;
     auto        get_r_token(bool br = false) -> Token;
     auto        get_x_token() -> bool;
+    auto        get_x_char_token() -> bool;
     void        get_x_token_or_active_char(symcodes &a, subtypes &b);
     void        glue_define(size_t a, Glue c, bool gbl);
     auto        grab_env_comma(TokenList &v) -> bool;
@@ -498,7 +504,7 @@ private:
     void        invalid_key(Token T, const std::string &key, const TokenList &val);
     auto        is_delimiter(const TokenList &L) -> bool;
     void        is_date_valid();
-    static auto is_env_on_stack(const std::string &s) -> SaveAuxEnv *;
+    static auto is_env_on_stack(const std::string &s) -> SaveAux *;
     auto        is_input_open() -> bool;
     static auto is_inner_math() -> bool;
     auto        is_not_a_math_env(String s) -> bool;
@@ -609,7 +615,8 @@ private:
     void        push_module();
     void        push_module(const std::string &aux);
     auto        push_par() -> Xid;
-    void        push_save_stack(SaveAux *v);
+    void        push_save_env(std::string a, std::string s, int ll, Token t, CmdChr c);
+    void        push_save_stack(SaveAux v);
     void        push_tpa();
     void        ratio_evaluate(TokenList &A, TokenList &B, SthInternal &res);
     auto        read_delimited(const TokenList &L) -> TokenList;
@@ -672,7 +679,7 @@ private:
     void        scan_group3(TokenList &res, int cl, bool exp, size_t N);
     void        scan_group4(TokenList &res, int cl);
     auto        scan_group_opt(TokenList &L, bool &have_arg) -> bool;
-    auto        scan_group_del(TokenList &res, const TokenList &L) -> bool;
+    auto        scan_group_del(TokenList &res, TokenSpan L, const uint32_t *F) -> bool;
     auto        scan_group_del1(TokenList &res, Token x) -> bool;
     void        scan_hbox(int ptr, subtypes c);
     void        scan_ignore_group();
@@ -745,7 +752,7 @@ private:
     void        skip_initial_space();
     void        skip_initial_space_and_back_input();
     void        skip_over_parens();
-    auto        skip_prefix(const TokenList &L) -> bool;
+    auto        skip_prefix(TokenSpan L) -> bool;
     void        solve_cite(bool user);
     void        special_fvset();
     auto        special_next_arg() -> std::string;
@@ -968,7 +975,7 @@ private:
     void        tipa_tildedot();
     void        tipa_syllabic();
     void        token_from_list(Token t);
-    void        token_list_define(size_t p, TokenList &c, bool gbl);
+    void        token_list_define(size_t p, SharedTokenList c, bool gbl);
     auto        token_list_to_dim(TokenList &a, Token C, bool spec) -> ScaledInt;
     auto        token_list_to_att(TokenList &a, Token C, bool spec) -> Istring;
     void        token_show(int what, Buffer &B);
@@ -983,6 +990,7 @@ private:
     void        translate1();
     void        translate_char(CmdChr X);
     void        translate_char(uchar c1, uchar c2);
+    void        translate_char_run();
     auto        translate_list(TokenList &L) -> Xml *;
     void        translate_font_size();
     void        umlaut();
@@ -794,12 +794,9 @@ void Parser::define_cmd_key(subtypes c) {
         LL.push_front(hash_table.locate("def"));
         brace_me(LL);
         back_input(LL);
-        auto *X = new Macro;
-        X->set_nbargs(1);
-        X->set_type(dt_normal);
-        read_mac_body(X->body, false, 1);
-        X->correct_type();
-        mac_define(T, X, false, rd_always, user_cmd);
+        TokenList body;
+        read_mac_body(body, false, 1);
+        mac_define(T, new Macro(1, dt_normal, nullptr, body), false, rd_always, user_cmd);
     }
 }
 
@@ -961,12 +958,9 @@ void Parser::define_bool_key(subtypes c) {
         LL.push_front(hash_table.xkv_cc_token);
         brace_me(LL);
         back_input(LL);
-        auto *X = new Macro;
-        X->set_nbargs(1);
-        X->set_type(dt_normal);
-        read_mac_body(X->body, false, 1);
-        X->correct_type();
-        mac_define(T, X, false, rd_always, user_cmd);
+        TokenList body;
+        read_mac_body(body, false, 1);
+        mac_define(T, new Macro(1, dt_normal, nullptr, body), false, rd_always, user_cmd);
     }
 }
 
@@ -1021,10 +1015,7 @@ void Parser::disable_keys() {
             TokenList L = B.str_toks(nlt_space); // should be irrelevant
             brace_me(L);
             L.push_front(hash_table.xkv_warn_token);
-            auto *X = new Macro(L);
-            X->set_nbargs(1);
-            X->set_type(dt_normal);
-            mac_define(T, X, false, rd_always, user_cmd);
+            mac_define(T, new Macro(1, dt_normal, nullptr, L), false, rd_always, user_cmd);
         } else
             parse_error(err_tok, "Undefined key cannot be disabled: ", Key, "");
     }
@@ -1191,12 +1182,9 @@ void Parser::internal_define_key_default(Token T, TokenList &L) {
 
 // This is like \def\T#1, optimised
 void Parser::internal_define_key(Token T) {
-    auto *X = new Macro;
-    X->set_nbargs(1);
-    X->set_type(dt_normal);
-    read_mac_body(X->body, false, 1);
-    X->correct_type();
-    mac_define(T, X, false, rd_always, user_cmd);
+    TokenList body;
+    read_mac_body(body, false, 1);
+    mac_define(T, new Macro(1, dt_normal, nullptr, body), false, rd_always, user_cmd);
 }
 
 // Skips initial + or *, catcode irrelevant
@@ -2214,8 +2202,8 @@ void Parser::T_use_counter(const std::string &s) {
     string_define(1, s, false);
     Buffer &b = local_buf;
     b << bf_reset << "c@" << s;
-    Token       T = hash_table.locate(b);
-    Equivalent &E = hash_table.eqtb[T.eqtb_loc()];
+    Token      T = hash_table.locate(b);
+    Equivalent E = hash_table.eqtb[T.eqtb_loc()];
     if (E.cmd != assign_int_cmd) return;
     word_define(E.chr, 0, true);
 }
@@ -19,10 +19,11 @@ namespace parser_ns {
 } // namespace parser_ns
 
 namespace {
-    std::vector<SaveAux *> the_save_stack;
-    Xml *                  the_box_to_end;
-    long                   the_box_position = -1; // \todo std::optional<size_t>
-    Buffer                 Thbuf1;
+    std::vector<SaveAux>     the_save_stack;
+    std::vector<std::string> the_save_strings; // strings of the SaveAux entries
+    Xml *                    the_box_to_end;
+    long                     the_box_position = -1; // \todo std::optional<size_t>
+    Buffer                   Thbuf1;
 } // namespace
 
 // --------------------------------------------------
@@ -31,7 +32,8 @@ auto to_string(save_type v) -> String {
     switch (v) {
     case st_boundary: return "boundary";
     case st_cmd: return "command";
-    case st_int: return "integer";
+    case st_int:
+    case st_catcode: return "integer"; // as when catcodes were in eqtb_int_table
     case st_dim: return "dimension";
     case st_glue: return "glue";
     case st_token: return "token";
@@ -79,6 +81,7 @@ SaveErrTok::SaveErrTok(Token t) {
 }
 
 Parser::Parser() : cur_env_name("document") {
+    catcodes                           = eqtb_int_table.data();
     sectionning_offset                 = section_code;
     restricted                         = false;
     cur_level                          = 1;
@@ -102,12 +105,48 @@ Parser::Parser() : cur_env_name("document") {
 
 // Saves in *this the catcode at position c, modifies it to be nc
 SaveCatcode::SaveCatcode(char32_t c, long nc) : character(c) {
-    code                                     = the_parser.eqtb_int_table[character].val;
-    the_parser.eqtb_int_table[character].val = nc;
+    code                               = the_parser.catcodes[character].val;
+    the_parser.catcodes[character].val = nc;
 }
 
 // Undoes a catcode change
-SaveCatcode::~SaveCatcode() { the_parser.eqtb_int_table[character].val = code; }
+SaveCatcode::~SaveCatcode() { the_parser.catcodes[character].val = code; }
+
+// Returns catcode table number k, null if it was never initialised.
+// Table 0 is the one at the start of eqtb_int_table.
+auto Parser::catcode_table(size_t k) -> EqtbInt * {
+    if (k == 0) return eqtb_int_table.data();
+    if (k >= catcode_tables.size() || catcode_tables[k] == nullptr) return nullptr;
+    return catcode_tables[k]->data();
+}
+
+// Implements \initcatcodetable N (c=0), that fills table N with the
+// catcodes of initex, and \savecatcodetable N (c=1), that copies the
+// current table into N. These assignments are global. Afterwards, switching
+// to N via \catcodetable=N only changes the pointer catcodes.
+void Parser::T_catcode_table(subtypes c) {
+    Token T = cur_tok;
+    auto  k = scan_int(T, 255, "catcode table number");
+    auto *W = catcode_table(k);
+    if (W == nullptr) {
+        if (k >= catcode_tables.size()) catcode_tables.resize(k + 1);
+        catcode_tables[k] = new CatcodeTable;
+        W                 = catcode_tables[k]->data();
+    }
+    if (c == one_code) {
+        for (size_t i = 0; i < nb_characters; i++) W[i] = {catcodes[i].val, 1};
+        return;
+    }
+    for (size_t i = 0; i < nb_characters; i++) W[i] = {other_catcode, 1};
+    for (size_t i = 'a'; i <= 'z'; i++) W[i].val = letter_catcode;
+    for (size_t i = 'A'; i <= 'Z'; i++) W[i].val = letter_catcode;
+    W[uchar('\\')].val = escape_catcode;
+    W[uchar('%')].val  = comment_catcode;
+    W[0].val           = ignored_catcode;
+    W[uchar('\r')].val = eol_catcode;
+    W[uchar(' ')].val  = space_catcode;
+    W[127].val         = invalid_catcode;
+}
 
 // saving and restoring things
 
@@ -149,23 +188,132 @@ auto operator<<(std::ostream &fp, const boundary_type &x) -> std::ostream & {
     return fp;
 }
 
+// Constructors of the entries of the save stack.
+auto SaveAux::boundary_entry(boundary_type v) -> SaveAux {
+    SaveAux R(st_boundary);
+    R.boundary = v;
+    return R;
+}
+
+auto SaveAux::int_entry(int l, size_t a, long b) -> SaveAux {
+    SaveAux R(st_int);
+    R.level   = l;
+    R.pos     = a;
+    R.int_val = b;
+    return R;
+}
+
+// The position encodes the catcode table k and the character c.
+auto SaveAux::catcode_entry(int l, size_t k, size_t c, long b) -> SaveAux {
+    SaveAux R(st_catcode);
+    R.level   = l;
+    R.pos     = k * nb_characters + c;
+    R.int_val = b;
+    return R;
+}
+
+auto SaveAux::dim_entry(int l, size_t a, ScaledInt b) -> SaveAux {
+    SaveAux R(st_dim);
+    R.level   = l;
+    R.pos     = a;
+    R.dim_val = b;
+    return R;
+}
+
+auto SaveAux::cmd_entry(size_t a, const Equivalent &X) -> SaveAux {
+    SaveAux R(st_cmd);
+    R.level   = X.level;
+    R.pos     = a;
+    R.cmd_val = X;
+    return R;
+}
+
+auto SaveAux::box_entry(int l, size_t a, Xml *b) -> SaveAux {
+    SaveAux R(st_box);
+    R.level   = l;
+    R.pos     = a;
+    R.box_val = b;
+    return R;
+}
+
+auto SaveAux::boxend_entry(size_t a, Xml *b) -> SaveAux {
+    SaveAux R(st_box_end);
+    R.pos     = a;
+    R.box_val = b;
+    return R;
+}
+
+auto SaveAux::token_entry(int l, size_t p, SharedTokenList v) -> SaveAux {
+    SaveAux R(st_token);
+    R.level    = l;
+    R.pos      = p;
+    R.toks_val = std::move(v);
+    return R;
+}
+
+auto SaveAux::glue_entry(int l, size_t p, Glue g) -> SaveAux {
+    SaveAux R(st_glue);
+    R.level    = l;
+    R.pos      = p;
+    R.glue_val = g;
+    return R;
+}
+
+// The value is the last element of the_save_strings.
+auto SaveAux::string_entry(int l, size_t p) -> SaveAux {
+    SaveAux R(st_string);
+    R.level = l;
+    R.pos   = p;
+    return R;
+}
+
+// The old and new names are at position k and k+1 of the_save_strings.
+auto SaveAux::env_entry(size_t k, int ll, Token b, CmdChr c) -> SaveAux {
+    SaveAux R(st_env);
+    R.pos     = k;
+    R.env_val = {b, c, ll};
+    return R;
+}
+
+auto SaveAux::font_entry(int l, long v, Istring c) -> SaveAux {
+    SaveAux R(st_font);
+    R.level    = l;
+    R.font_val = {v, c};
+    return R;
+}
+
+auto SaveAux::aftergroup_entry(Token v) -> SaveAux {
+    SaveAux R(st_save);
+    R.tok_val = v;
+    return R;
+}
+
 // This adds a new element to the save stack.
-void Parser::push_save_stack(SaveAux *v) {
+void Parser::push_save_stack(SaveAux v) {
     my_stats.one_more_up();
-    v->set_line(get_cur_line());
-    the_save_stack.push_back(v);
+    v.line = get_cur_line();
+    the_save_stack.push_back(std::move(v));
+}
+
+// This pushes the slot of \begin{foo}, s is foo; the slot restores the
+// current environment name a and its line ll.
+void Parser::push_save_env(std::string a, std::string s, int ll, Token t, CmdChr c) {
+    auto k = the_save_strings.size();
+    the_save_strings.push_back(std::move(a));
+    the_save_strings.push_back(std::move(s));
+    push_save_stack(SaveAux::env_entry(k, ll, t, c));
 }
 
 // This is done when we evaluate { or \begingroup.
 void Parser::push_level(boundary_type v) {
-    push_save_stack(new SaveAuxBoundary(v));
+    push_save_stack(SaveAux::boundary_entry(v));
     cur_level++;
     if (tracing_stack())
         the_log << lg_startstack << "level + " << cur_level << " for " << v << " entered on line " << get_cur_line() << lg_end;
 }
 
 void Parser::push_tpa() {
-    push_save_stack(new SaveAuxBoundary(bt_tpa));
+    push_save_stack(SaveAux::boundary_entry(bt_tpa));
     if (tracing_stack()) the_log << lg_startstack << "level = " << cur_level << " for " << bt_tpa << lg_end;
 }
 
@@ -177,7 +325,7 @@ void Parser::push_tpa() {
 void Parser::eq_define(size_t a, CmdChr bc, bool gbl) {
     if (bc.is_user()) mac_table.incr_macro_ref(bc.chr);
     if (!gbl && hash_table.eqtb[a].must_push(cur_level))
-        push_save_stack(new SaveAuxCmd(a, hash_table.eqtb[a]));
+        push_save_stack(SaveAux::cmd_entry(a, hash_table.eqtb[a]));
     else if (hash_table.eqtb[a].is_user())
         mac_table.delete_macro_ref(hash_table.eqtb[a].chr);
     if (gbl)
@@ -202,7 +350,7 @@ void Parser::mac_define(Token a, Macro *b, bool gbl, rd_flag redef, symcodes wha
         }
         eq_define(a.eqtb_loc(), nv, gbl);
     } else
-        delete b;
+        mac_table.delete_macro(b);
 }
 
 // For \newcommand, \renewcommand: we signal an error if we cannot define
@@ -227,8 +375,15 @@ auto Parser::ok_to_define(Token a, rd_flag redef) -> bool {
 }
 
 // Define for an integer quantity. Like eq_define without reference counts.
+// Catcodes are taken from the current catcode table, and the value of
+// \catcodetable says which one this is.
 void Parser::word_define(size_t a, long c, bool gbl) {
-    EqtbInt &W        = eqtb_int_table[a];
+    if (a == catcodetable_code && (c < 0 || catcode_table(to_unsigned(c)) == nullptr)) {
+        parse_error(err_tok, "Invalid \\catcodetable ", std::to_string(c), "bad catcode table");
+        return;
+    }
+    bool     is_cat   = a < nb_characters;
+    EqtbInt &W        = is_cat ? catcodes[a] : eqtb_int_table[a];
     bool     reassign = !gbl && W.val == c;
     if (tracing_assigns()) {
         CmdChr tmp(assign_int_cmd, subtypes(a));
@@ -241,9 +396,15 @@ void Parser::word_define(size_t a, long c, bool gbl) {
     else if (reassign)
         return;
     else {
-        if (W.must_push(cur_level)) push_save_stack(new SaveAuxInt(W.level, a, W.val));
+        if (W.must_push(cur_level)) {
+            if (is_cat)
+                push_save_stack(SaveAux::catcode_entry(W.level, to_unsigned(eqtb_int_table[catcodetable_code].val), a, W.val));
+            else
+                push_save_stack(SaveAux::int_entry(W.level, a, W.val));
+        }
         W = {c, cur_level};
     }
+    if (a == catcodetable_code) catcodes = catcode_table(to_unsigned(c));
 }
 // Define for an string quantity. Like eq_define without reference counts.
 void Parser::string_define(size_t a, const std::string &c, bool gbl) {
@@ -259,7 +420,10 @@ void Parser::string_define(size_t a, const std::string &c, bool gbl) {
     else if (reassign)
         return;
     else {
-        if (W.must_push(cur_level)) push_save_stack(new SaveAuxString(W.level, a, W.val));
+        if (W.must_push(cur_level)) {
+            the_save_strings.push_back(std::move(W.val));
+            push_save_stack(SaveAux::string_entry(W.level, a));
+        }
         W = {c, cur_level};
     }
 }
@@ -279,7 +443,7 @@ void Parser::dim_define(size_t a, ScaledInt c, bool gbl) {
     else if (reassign)
         return;
     else {
-        if (W.must_push(cur_level)) push_save_stack(new SaveAuxDim(W.level, a, W.val));
+        if (W.must_push(cur_level)) push_save_stack(SaveAux::dim_entry(W.level, a, W.val));
         W = {c, cur_level};
     }
 }
@@ -310,7 +474,7 @@ void Parser::glue_define(size_t a, Glue c, bool gbl) {
     else if (reassign)
         return;
     else {
-        if (W.must_push(cur_level)) push_save_stack(new SaveAuxGlue(W.level, a, W.val));
+        if (W.must_push(cur_level)) push_save_stack(SaveAux::glue_entry(W.level, a, W.val));
         W = {c, cur_level};
     }
 }
@@ -325,13 +489,13 @@ void Parser::box_define(size_t a, Xml *c, bool gbl) {
     if (gbl)
         W = {c, 1};
     else {
-        if (W.must_push(cur_level)) push_save_stack(new SaveAuxBox(W.level, a, W.val));
+        if (W.must_push(cur_level)) push_save_stack(SaveAux::box_entry(W.level, a, W.val));
         W = {c, cur_level};
     }
 }
 
 // Same code for a token list.
-void Parser::token_list_define(size_t p, TokenList &c, bool gbl) {
+void Parser::token_list_define(size_t p, SharedTokenList c, bool gbl) {
     EqtbToken &W        = toks_registers[p];
     bool       reassign = !gbl && W.val == c;
     if (tracing_assigns()) {
@@ -341,12 +505,12 @@ void Parser::token_list_define(size_t p, TokenList &c, bool gbl) {
         the_log << lg_endbrace;
     }
     if (gbl)
-        W = {c, 1};
+        W = {std::move(c), 1};
     else if (reassign)
         return;
     else {
-        if (W.must_push(cur_level)) push_save_stack(new SaveAuxToken(W.level, p, W.val));
-        W = {c, cur_level};
+        if (W.must_push(cur_level)) push_save_stack(SaveAux::token_entry(W.level, p, std::move(W.val)));
+        W = {std::move(c), cur_level};
     }
 }
 
@@ -355,17 +519,36 @@ void Parser::token_list_define(size_t p, TokenList &c, bool gbl) {
 void Parser::save_font() {
     if (tracing_commands()) the_log << lg_startbrace << "font change " << cur_font << lg_endbrace;
     if (cur_font.level == cur_level) return;
-    push_save_stack(new SaveAuxFont(cur_font.level, cur_font.old, cur_font.old_color));
+    push_save_stack(SaveAux::font_entry(cur_font.level, cur_font.old, cur_font.old_color));
     cur_font.set_level(cur_level);
 }
 
+// Restores the entry; this is done after it has been removed from the stack.
+void SaveAux::unsave(bool trace, Parser &P) {
+    switch (type) {
+    case st_boundary: unsave_boundary(trace, P); return;
+    case st_cmd: unsave_cmd(trace, P); return;
+    case st_int:
+    case st_catcode: unsave_int(trace, P); return;
+    case st_dim: unsave_dim(trace, P); return;
+    case st_glue: unsave_glue(trace, P); return;
+    case st_token: unsave_token(trace, P); return;
+    case st_save: unsave_aftergroup(trace, P); return;
+    case st_env: unsave_env(trace, P); return;
+    case st_font: unsave_font(trace, P); return;
+    case st_box: unsave_box(trace, P); return;
+    case st_box_end: unsave_boxend(trace, P); return;
+    case st_string: unsave_string(trace, P); return;
+    }
+}
+
 // When we pop a level, the current font may change.
-void SaveAuxFont::unsave(bool trace, Parser &P) {
+void SaveAux::unsave_font(bool trace, Parser &P) const {
     P.flush_buffer();
     P.cur_font.set_old_from_packed();
     P.cur_font.set_level(level);
-    P.cur_font.set_packed(value);
-    P.cur_font.set_color(color);
+    P.cur_font.set_packed(font_val.value);
+    P.cur_font.set_color(font_val.color);
     P.cur_font.unpack();
     if (trace) the_log << lg_startstack << "restoring current font " << P.cur_font << lg_endsentence;
     P.font_has_changed1();
@@ -378,51 +561,60 @@ void SaveAuxFont::unsave(bool trace, Parser &P) {
 void SaveAux::restore_or_retain(bool rt, String s) { the_log << lg_startstack << (rt ? "restoring " : "retaining ") << s; }
 
 // This done when we restore an integer value
-void SaveAuxInt::unsave(bool trace, Parser &P) {
-    bool rt = P.eqtb_int_table[pos].level != 1;
+// For a catcode, pos says which table to use.
+void SaveAux::unsave_int(bool trace, Parser &P) const {
+    bool     is_cat = type == st_catcode;
+    auto     k      = is_cat ? pos % nb_characters : pos;
+    EqtbInt &W      = is_cat ? P.catcode_table(pos / nb_characters)[k] : P.eqtb_int_table[pos];
+    bool     rt     = W.level != 1;
     if (trace) {
         restore_or_retain(rt, "\\");
-        CmdChr tmp(assign_int_cmd, subtypes(pos));
-        the_log << tmp.name() << "=" << val << lg_endsentence;
+        CmdChr tmp(assign_int_cmd, subtypes(k));
+        the_log << tmp.name() << "=" << int_val << lg_endsentence;
     }
-    if (rt) P.eqtb_int_table[pos] = {val, level};
+    if (rt) W = {int_val, level};
+    if (pos == catcodetable_code && !is_cat) P.catcodes = P.catcode_table(to_unsigned(P.eqtb_int_table[pos].val));
 }
 
 // This done when we restore a string value
 //
-void SaveAuxString::unsave(bool trace, Parser &P) {
+void SaveAux::unsave_string(bool trace, Parser &P) const {
+    std::string val = std::move(the_save_strings.back());
+    the_save_strings.pop_back();
     bool rt = P.eqtb_string_table[pos].level != 1;
     if (trace) { the_log << lg_startstack << "restoring " << parser_ns::save_string_name(pos) << "=" << val << lg_endsentence; }
-    if (rt) P.eqtb_string_table[pos] = {val, level};
+    if (rt) P.eqtb_string_table[pos] = {std::move(val), level};
 }
 
 // This done when we restore a dimension value
-void SaveAuxDim::unsave(bool trace, Parser &P) {
+void SaveAux::unsave_dim(bool trace, Parser &P) const {
     bool rt = P.eqtb_dim_table[pos].level != 1;
     if (trace) {
         restore_or_retain(rt, "\\");
         CmdChr tmp(assign_dimen_cmd, subtypes(pos));
-        the_log << tmp.name() << "=" << val << lg_endsentence;
+        the_log << tmp.name() << "=" << dim_val << lg_endsentence;
     }
-    if (rt) P.eqtb_dim_table[pos] = {val, level};
+    if (rt) P.eqtb_dim_table[pos] = {dim_val, level};
 }
 
 // Restore glue
-void SaveAuxGlue::unsave(bool trace, Parser &P) {
+void SaveAux::unsave_glue(bool trace, Parser &P) const {
     bool rt = P.glue_table[pos].level != 1;
     if (trace) {
-        Thbuf1 << bf_reset << val;
+        Thbuf1 << bf_reset << glue_val;
         if (pos >= thinmuskip_code) Thbuf1.pt_to_mu();
         restore_or_retain(rt, "\\");
         CmdChr tmp(assign_glue_cmd, subtypes(pos));
         the_log << tmp.name() << "=" << Thbuf1 << lg_endsentence;
     }
-    if (rt) P.glue_table[pos] = {val, level};
+    if (rt) P.glue_table[pos] = {glue_val, level};
 }
 
 // Restore command. We have to take care to free memory for user commands.
-void SaveAuxCmd::unsave(bool trace, Parser &P) {
-    int lvl = P.hash_table.eqtb[cs].level;
+void SaveAux::unsave_cmd(bool trace, Parser &P) const {
+    size_t        cs  = pos;
+    const CmdChr &val = cmd_val;
+    int           lvl = P.hash_table.eqtb[cs].level;
     if (trace) {
         String S = lvl == 1 ? "retaining " : (val.is_undef() ? "killing " : "restoring ");
         the_log << lg_startstack << S << Token(cs + eqtb_offset);
@@ -445,52 +637,61 @@ void SaveAuxCmd::unsave(bool trace, Parser &P) {
 }
 
 // Restore token list.
-void SaveAuxToken::unsave(bool trace, Parser &P) {
+void SaveAux::unsave_token(bool trace, Parser &P) {
     bool rt = P.toks_registers[pos].level != 1;
     if (trace) {
         restore_or_retain(rt, "\\");
         CmdChr tmp(assign_toks_cmd, subtypes(pos));
-        the_log << tmp.name() << "=" << val << lg_endsentence;
+        the_log << tmp.name() << "=" << toks_val << lg_endsentence;
     }
-    if (rt) P.toks_registers[pos] = {val, level};
+    if (rt) P.toks_registers[pos] = {std::move(toks_val), level};
 }
 
 // Restore box. Called in the case {\setbox0=\hbox{...}}
 // when we see the last closing brace. This may restore box0.
-void SaveAuxBox::unsave(bool trace, Parser &P) {
+void SaveAux::unsave_box(bool trace, Parser &P) const {
     bool rt = P.box_table[pos].level != 1;
     if (trace) {
         restore_or_retain(rt, "\\box");
         the_log << pos << lg_endsentence;
     }
-    if (rt) P.box_table[pos] = {val, level};
+    if (rt) P.box_table[pos] = {box_val, level};
 }
 
 // Restore box. Called in the case {\setbox0=\hbox{...}}
 // when we see the first closing brace. The box just created will be put in
 // box0.
-void SaveAuxBoxend::unsave(bool trace, Parser &P) {
+void SaveAux::unsave_boxend(bool trace, Parser &P) const {
     if (trace) the_log << lg_startstack << "finish a box of type " << pos << lg_end;
     P.flush_buffer();
     P.the_stack.pop(the_names[cst_hbox]);
-    the_box_to_end   = val;
+    the_box_to_end   = box_val;
     the_box_position = to_signed(pos);
 }
 
 // \aftergroup\foo{}: When the group is finished, the token \foo is
 // pushed back into the input stream.
-void SaveAuxAftergroup::unsave(bool trace, Parser &P) {
-    if (trace) the_log << lg_startstack << "after group " << value << lg_end;
-    P.back_input(value);
+void SaveAux::unsave_aftergroup(bool trace, Parser &P) const {
+    if (trace) the_log << lg_startstack << "after group " << tok_val << lg_end;
+    P.back_input(tok_val);
+}
+
+// This is executed when we pop a slot containing restore-foo-env
+void SaveAux::unsave_env(bool trace, Parser &P) const {
+    std::string name    = std::move(the_save_strings[pos + 1]);
+    std::string oldname = std::move(the_save_strings[pos]);
+    the_save_strings.resize(pos);
+    if (trace) the_log << lg_startstack << "ending environment " << name << "; resuming " << oldname << ".\n";
+    P.set_cur_env_name(std::move(oldname), env_val.line);
 }
 
 // Consider the case of {\setbox0=\hbox{...}}
 // We must call box_end, the function that fills box0 with the current box.
-// The number of the box is set by SaveAuxBoxend into the_box_position
+// The number of the box is set by the st_box_end entry into the_box_position
 // But this function cannot call box_end (because we are still in the {...}
 // group. Hence box_end must be called after cur_level is decremented.
-void SaveAuxBoundary::unsave(bool trace, Parser &P) {
-    if (trace) the_log << lg_startstack << "level - " << P.get_cur_level() << " for " << val << " from line " << line << lg_end;
+void SaveAux::unsave_boundary(bool trace, Parser &P) const {
+    if (trace) the_log << lg_startstack << "level - " << P.get_cur_level() << " for " << boundary << " from line " << line << lg_end;
     P.decr_cur_level();
     if (the_box_position >= 0) {
         if (the_box_to_end != nullptr) the_box_to_end->remove_last_empty_hi();
@@ -506,10 +707,10 @@ static int first_boundary_loc = 0;
 auto       Parser::first_boundary() -> boundary_type {
     auto n = the_save_stack.size();
     for (size_t i = n; i > 0; i--) {
-        SaveAux *p = the_save_stack[i - 1];
-        if (p->type != st_boundary) continue;
-        first_boundary_loc = p->line;
-        return dynamic_cast<SaveAuxBoundary *>(p)->val;
+        const SaveAux &p = the_save_stack[i - 1];
+        if (p.type != st_boundary) continue;
+        first_boundary_loc = p.line;
+        return p.boundary;
     }
     return bt_impossible;
 }
@@ -520,9 +721,9 @@ auto Parser::stack_math_in_cell() -> bool {
     auto n     = the_save_stack.size();
     bool first = true;
     for (size_t i = n; i > 0; i--) {
-        SaveAux *p = the_save_stack[i - 1];
-        if (p->type != st_boundary) continue;
-        boundary_type cur = dynamic_cast<SaveAuxBoundary *>(p)->val;
+        const SaveAux &p = the_save_stack[i - 1];
+        if (p.type != st_boundary) continue;
+        boundary_type cur = p.boundary;
         if (cur == bt_brace || cur == bt_semisimple) continue;
         if (first) {
             if (cur != bt_math) return false;
@@ -538,15 +739,15 @@ void Parser::dump_save_stack() {
     int  L = cur_level - 1;
     auto n = the_save_stack.size();
     for (size_t i = n; i > 0; i--) {
-        SaveAux *p = the_save_stack[i - 1];
-        if (p->type != st_boundary) continue;
-        dynamic_cast<SaveAuxBoundary *>(p)->dump(L);
+        const SaveAux &p = the_save_stack[i - 1];
+        if (p.type != st_boundary) continue;
+        p.dump(L);
         --L;
     }
     the_log << "### bottom level\n";
 }
-void SaveAuxBoundary::dump(int n) {
-    String s = val == bt_semisimple ? "semi simple" : parser_ns::to_string(val);
+void SaveAux::dump(int n) const {
+    String s = boundary == bt_semisimple ? "semi simple" : parser_ns::to_string(boundary);
     the_log << "### " << s << " group (level " << n << ") entered at line " << line << "\n";
 }
 
@@ -593,12 +794,11 @@ void Parser::pop_level(boundary_type v) {
             parse_error(err_tok, "Internal error: empty save stack");
             return;
         }
-        SaveAux *tmp = the_save_stack.back();
-        bool     ok  = tmp->type == st_boundary;
+        SaveAux tmp = std::move(the_save_stack.back());
+        bool    ok  = tmp.type == st_boundary;
         the_save_stack.pop_back();
-        tmp->unsave(trace, *this);
+        tmp.unsave(trace, *this);
         my_stats.one_more_down();
-        delete tmp;
         if (ok) {
             if (must_throw) {
                 cur_level++;
@@ -619,15 +819,12 @@ void Parser::pop_all_levels() {
     B.reset();
     for (;;) {
         if (the_save_stack.empty()) break;
-        SaveAux *tmp = the_save_stack.back();
-        std::cout << to_string(tmp->type) << " at " << tmp->line << "\n";
-        if (tmp->type == st_env) {
-            auto *q = dynamic_cast<SaveAuxEnv *>(tmp);
-            ename   = q->name;
-        }
-        if (tmp->type == st_boundary) {
-            boundary_type w = dynamic_cast<SaveAuxBoundary *>(tmp)->val;
-            int           l = tmp->line;
+        SaveAux tmp = std::move(the_save_stack.back());
+        std::cout << to_string(tmp.type) << " at " << tmp.line << "\n";
+        if (tmp.type == st_env) ename = the_save_strings[tmp.pos + 1];
+        if (tmp.type == st_boundary) {
+            boundary_type w = tmp.boundary;
+            int           l = tmp.line;
             if (started) {
                 B << ".\n"; // finish prev line
                 main_ns::nb_errs++;
@@ -638,9 +835,8 @@ void Parser::pop_all_levels() {
             B << " started at line " << l;
         }
         the_save_stack.pop_back();
-        tmp->unsave(false, *this);
+        tmp.unsave(false, *this);
         my_stats.one_more_down();
-        delete tmp;
     }
     if (started) {
         signal_error(Token(), "");
@@ -656,12 +852,11 @@ void Parser::final_checks() {
     conditions.terminate();
     auto n = the_save_stack.size();
     if (n == 1) {
-        SaveAux *tmp = the_save_stack.back();
-        if (tmp->type == st_font) {
+        if (the_save_stack.back().type == st_font) {
+            SaveAux tmp = std::move(the_save_stack.back());
             the_save_stack.pop_back();
-            tmp->unsave(false, *this);
+            tmp.unsave(false, *this);
             my_stats.one_more_down();
-            delete tmp;
             n = the_save_stack.size();
         }
     }
@@ -671,9 +866,9 @@ void Parser::final_checks() {
     B.reset();
     Buffer &A = Thbuf1;
     for (size_t i = n; i > 0; i--) {
-        SaveAux *p = the_save_stack[i - 1];
+        const SaveAux &p = the_save_stack[i - 1];
         A.reset();
-        A << to_string(p->type) << " at " << p->line;
+        A << to_string(p.type) << " at " << p.line;
         if (B.empty()) {
             B << "  " << A;
         } else if (B.size() + A.size() < 78) {
@@ -688,13 +883,12 @@ void Parser::final_checks() {
 }
 
 // Returns the slot associated to the env S
-auto Parser::is_env_on_stack(const std::string &s) -> SaveAuxEnv * {
+auto Parser::is_env_on_stack(const std::string &s) -> SaveAux * {
     auto n = the_save_stack.size();
     for (size_t i = n; i > 0; i--) {
-        SaveAux *p = the_save_stack[i - 1];
-        if (p->type != st_env) continue;
-        auto *q = dynamic_cast<SaveAuxEnv *>(p);
-        if (q->name == s) return q;
+        SaveAux &p = the_save_stack[i - 1];
+        if (p.type != st_env) continue;
+        if (the_save_strings[p.pos + 1] == s) return &p;
     }
     return nullptr;
 }
@@ -704,8 +898,7 @@ auto Parser::nb_env_on_stack() -> int {
     auto n = the_save_stack.size();
     int  k = 0;
     for (size_t i = n; i > 0; i--) {
-        SaveAux *p = the_save_stack[i - 1];
-        if (p->type == st_env) ++k;
+        if (the_save_stack[i - 1].type == st_env) ++k;
     }
     return k;
 }
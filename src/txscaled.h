@@ -106,10 +106,10 @@ public:
 // This is a union of different things
 // it contains the result of scan_something_internal
 class SthInternal {
-    Glue          glue_val;     // value if it is a glue
-    ScaledInt     int_val;      // value if it is a dimension or an integer
-    TokenList     token_val;    // value if it is a token list
-    internal_type type{it_int}; // this says what the object is.
+    Glue            glue_val;     // value if it is a glue
+    ScaledInt       int_val;      // value if it is a dimension or an integer
+    SharedTokenList token_val;    // value if it is a token list
+    internal_type   type{it_int}; // this says what the object is.
 public:
     SthInternal() : int_val(0) {}
     [[nodiscard]] auto is_int() const -> bool { return type == it_int; }
@@ -162,7 +162,7 @@ public:
         glue_val = a;
         type     = it_mu;
     }
-    void set_toks(TokenList a) {
+    void set_toks(SharedTokenList a) {
         token_val = std::move(a);
         type      = it_tok;
     }
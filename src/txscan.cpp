@@ -14,6 +14,8 @@
 #include "txmath.h"
 #include "txparser.h"
 
+extern MathDataP math_data;
+
 namespace {
     Buffer                           scratch;                            // See insert_string
     TexFonts                         tfonts;                             // the font table
@@ -71,11 +73,12 @@ void TexOutStream::close(size_t chan) {
 
 // This opens an output channel.
 // What if the file cannot be opened ?
-void TexOutStream::open(size_t chan, const std::string &file_name) {
+void TexOutStream::open(size_t chan, const std::string &name) {
     if (chan < 0 || chan > max_openout) return; // This cannot happen
     close(chan);
-    String fn = tralics_ns::get_out_dir(file_name);
-    auto * fp = new std::fstream(fn, std::ios::out);
+    String fn = tralics_ns::get_out_dir(name);
+    tralics_ns::forget_dir_index();
+    auto *fp = new std::fstream(fn, std::ios::out);
     if (fp == nullptr) return; // no error ?
     if (!*fp) return;          // no error ?
     write_file[chan] = fp;
@@ -120,15 +123,16 @@ void Parser::M_extension(int cc) {
     auto uchan = to_unsigned(chan);
     if (cc == openout_code) {
         scan_optional_equals();
-        std::string file_name = scan_file_name();
-        tex_out_stream.open(uchan, file_name);
+        std::string name = scan_file_name();
+        tex_out_stream.open(uchan, name);
     } else if (cc == closeout_code)
         tex_out_stream.close(uchan);
     else { // write to uchan
         String s = string_to_write(chan);
-        if (uchan == write18_slot)
+        if (uchan == write18_slot) {
             system(s);
-        else if (tex_out_stream.is_open(uchan))
+            tralics_ns::forget_dir_index();
+        } else if (tex_out_stream.is_open(uchan))
             tex_out_stream.write(uchan, s);
         else if (uchan == negative_out_slot)
             the_log << s;
@@ -180,8 +184,8 @@ void Parser::push_input_stack(const std::string &name, bool restore_at, bool re)
     W->line     = input_line;
     W->TL.swap(TL);
     if (restore_at) {
-        W->at_val                      = eqtb_int_table[uchar('@')].val;
-        eqtb_int_table[uchar('@')].val = 11;
+        W->at_val                = catcodes[uchar('@')].val;
+        catcodes[uchar('@')].val = 11;
         the_log << lg_start_io << "Made @ a letter\n";
     }
     every_eof   = false; // might be set to true
@@ -209,7 +213,7 @@ void Parser::pop_input_stack(bool vb) {
     require_eof = W->eof_outer;
     auto at     = W->at_val;
     if (at >= 0) {
-        eqtb_int_table[uchar('@')].val = at;
+        catcodes[uchar('@')].val = at;
         if (tracing_io()) the_log << lg_start_io << "Catcode of @ restored to " << at << lg_end;
     }
     input_line.clear();
@@ -246,18 +250,18 @@ void Parser::close_all() {
 // A file name is a special thing in TeX.
 // We read until we find a non-char, or a space.
 auto Parser::scan_file_name() -> std::string {
-    static Buffer file_name;
+    static Buffer name;
 
     if (name_in_progress) return "sabotage!"; // recursion killer.
     name_in_progress = true;
     remove_initial_space_and_back_input();
-    file_name.reset();
+    name.reset();
     for (;;) {
         if (get_x_token()) break;
         if (cur_cmd_chr.is_letter_other())
-            file_name.push_back(cur_cmd_chr.char_val());
+            name.push_back(cur_cmd_chr.char_val());
         else if (cur_cmd_chr.cmd == underscore_catcode) // allow foo_bar
-            file_name.push_back(cur_cmd_chr.char_val());
+            name.push_back(cur_cmd_chr.char_val());
         else if (cur_cmd_chr.is_space())
             break;
         else {
@@ -266,7 +270,7 @@ auto Parser::scan_file_name() -> std::string {
         }
     }
     name_in_progress = false;
-    return file_name.to_string();
+    return name.to_string();
 }
 
 // This implements \endinput, \scantokens
@@ -473,6 +477,9 @@ auto Parser::scan_double_hat(codepoint c) -> bool {
 }
 
 // This constructs a command name from the current line
+// In the usual case of an ascii name, the hash code is computed while
+// scanning, and the name is looked up in place, without copying it into
+// mac_buffer; this buffer is used only if ^^ or a non-ascii letter is seen.
 auto Parser::cs_from_input() -> Token {
     if (at_eol()) return Token(null_tok_val);
     codepoint c = get_next_char();
@@ -483,8 +490,15 @@ auto Parser::cs_from_input() -> Token {
     }
     int C = get_catcode(c.value);
     if (C == letter_catcode) {
-        mac_buffer.reset();
-        mac_buffer.push_back(c);
+        auto   start     = input_line_pos - 1;
+        bool   in_buffer = false;                                        // true if the name is in mac_buffer
+        size_t h         = Hashtab::hash_step(Hashtab::hash_seed, c.value); // hash code of the name
+        auto   to_buffer = [&](size_t end) {
+            mac_buffer.reset();
+            for (auto i = start; i < end; i++) mac_buffer.push_back(input_line[i]);
+            in_buffer = true;
+        };
+        if (!c.is_ascii()) to_buffer(input_line_pos);
         for (;;) {
             if (at_eol()) break;
             c = get_next_char();
@@ -494,16 +508,25 @@ auto Parser::cs_from_input() -> Token {
             } // abort
             C = get_catcode(c.value);
             if (C == letter_catcode) {
-                mac_buffer.push_back(c);
+                if (!in_buffer && !c.is_ascii()) to_buffer(input_line_pos - 1);
+                if (in_buffer)
+                    mac_buffer.push_back(c);
+                else
+                    h = Hashtab::hash_step(h, c.value);
                 continue;
             }
             if (C == hat_catcode) {
-                if (scan_double_hat(c)) continue;
+                auto k = input_line_pos - 1;
+                if (scan_double_hat(c)) {
+                    if (!in_buffer) to_buffer(k);
+                    continue;
+                }
             }
             --input_line_pos;
             break;
         }
-        return hash_table.locate(mac_buffer);
+        if (in_buffer) return hash_table.locate(mac_buffer);
+        return hash_table.locate(input_line.data() + start, input_line_pos - start, h);
     }
     if (C == space_catcode) return Token(c);
     if (C == hat_catcode) {
@@ -639,6 +662,31 @@ auto Parser::get_token() -> bool {
     return err;
 }
 
+// Same as get_x_token, used when scanning numbers and units. Character
+// tokens are neither expandable nor outer, hence if the next token is a
+// character at the start of TL, or a letter or other char of the current
+// line (next_from_line0 would produce it in the default case), we take it
+// directly.
+auto Parser::get_x_char_token() -> bool {
+    if (!TL.empty()) {
+        if (!TL.front().not_a_cmd()) return get_x_token();
+        cur_tok = TL.front();
+        TL.pop_front();
+        see_char_token(cur_tok);
+        return false;
+    }
+    if (restricted || at_eol()) return get_x_token();
+    codepoint c = input_line[input_line_pos];
+    if (c.is_big()) return get_x_token();
+    auto cat = get_catcode(c.value);
+    if (cat != letter_catcode && cat != other_catcode) return get_x_token();
+    input_line_pos++;
+    state       = state_M;
+    cur_cmd_chr = CmdChr(cat, subtypes(c.value));
+    cur_tok.from_cmd_chr(cur_cmd_chr);
+    return false;
+}
+
 // Reads a token that can be outer for \ifx \ifdefined or \show
 // no outer check, thus no error.
 auto Parser::get_token_o() -> bool {
@@ -930,16 +978,16 @@ auto Parser::get_a_new_line() -> bool {
 // A whole line is read. If braces are unbalanced, a second (or third...)
 // line is read.
 auto Parser::read_from_file(long ch, bool rl_sw) -> TokenList {
-    std::string file_name = "tty";
+    std::string name = "tty";
     if (ch < 0 || ch >= nb_input_channels)
         cur_in_chan = tty_in_chan;
     else if (!tex_input_files[ch].is_open())
         cur_in_chan = tty_in_chan;
     else {
         cur_in_chan = ch;
-        file_name   = tex_input_files[ch].get_lines().file_name;
+        name        = tex_input_files[ch].get_lines().file_name;
     }
-    push_input_stack(file_name, false, true);
+    push_input_stack(name, false, true);
     TokenList L;
     new_line_for_read(true);
     int b = 0;
@@ -1102,7 +1150,7 @@ auto Parser::scan_fifteen_bit_int() -> size_t { return scan_int(cur_tok, 32767,
 auto Parser::scan_sign() -> bool {
     bool negative = false;
     for (;;) {
-        get_x_token();
+        get_x_char_token();
         if (cur_cmd_chr.is_space()) continue;
         if (cur_tok.is_minus_token())
             negative = !negative;
@@ -1150,11 +1198,11 @@ auto Parser::scan_int_digs() -> long {
     if (cur_tok.is_singlequote()) {
         radix = 8;
         m     = 1 << 28;
-        get_x_token();
+        get_x_char_token();
     } else if (cur_tok.is_doublequote()) {
         radix = 16;
         m     = 1 << 27;
-        get_x_token();
+        get_x_char_token();
     }
     bool vacuous = true;
     long val     = 0;
@@ -1174,7 +1222,7 @@ auto Parser::scan_int_digs() -> long {
             val = max_integer; // this is 2^{31}-1
         } else
             val = val * to_signed(radix) + d;
-        get_x_token();
+        get_x_char_token();
     }
     if (vacuous) { // cur_tok cannot be a space here
         if (cur_tok.is_valid()) back_input();
@@ -1351,6 +1399,7 @@ void Parser::scan_something_internal(internal_type level) {
         Token T  = cur_tok;
         auto  k  = scan_mathfont_ident();
         auto  vv = scan_int(T, 127, "mathchar");
+        math_data.need_xml();
         if (level != it_tok) {
             cur_tok = T;
             bad_number();
@@ -1402,7 +1451,7 @@ void Parser::scan_something_internal(internal_type level) {
         return;
     case def_code_cmd: // \catcode, \lccode etc
         v = scan_char_num();
-        cur_val.set_int(eqtb_int_table[v + m].val);
+        cur_val.set_int(m == cat_code_offset ? catcodes[v].val : eqtb_int_table[v + m].val);
         return;
     case def_family_cmd:       // \textfont
     case set_font_cmd:         // a font (like \tenrm in plain)
@@ -1510,7 +1559,7 @@ void Parser::scan_double(RealNumber &res) {
     bool is_decimal = true;
     //  0.5 is the same as .5; case of initial dot is trivial
     if (!cur_tok.is_dec_separator()) {
-        get_x_token();
+        get_x_char_token();
         if (cur_tok.is_invalid()) {
             missing_number();
             return;
@@ -1535,7 +1584,7 @@ void Parser::scan_double(RealNumber &res) {
     long   table[17];
     size_t k = 0;
     for (;;) {
-        get_x_token();
+        get_x_char_token();
         if (!cur_tok.is_digit_token()) break;
         if (k < 17) {
             table[k] = to_signed(cur_tok.val_as_digit());
@@ -1554,7 +1603,7 @@ auto Parser::read_unit() -> int {
     if (cur_tok.is_a_char()) {
         c1         = cur_cmd_chr.char_val().to_lower();
         Token save = cur_tok;
-        get_x_token();
+        get_x_char_token();
         if (cur_tok.is_a_char()) {
             c2 = cur_cmd_chr.char_val().to_lower();
             if (c1 == 'p' && c2 == 't') return unit_pt;
@@ -1892,6 +1941,7 @@ void Parser::M_prefixed_aux(bool gbl) {
         scan_optional_equals();
         flush_buffer();
         std::string value = sT_arg_nopar();
+        math_data.need_xml();
         set_math_char(static_cast<uchar>(v), k, value);
         return;
     }
@@ -2021,13 +2071,12 @@ void Parser::assign_toks(Token T, size_t p, bool gbl) {
     }
     if (have_reg) {
         if (p == q) return;
-        TokenList Q = toks_registers[q].val;
-        token_list_define(p, Q, gbl);
+        token_list_define(p, toks_registers[q].val, gbl);
     } else { // this is scan_toks (false,false)
         SaveScannerStatus tmp(ss_absorbing);
         TokenList         Q;
         skip_group0(Q);
-        token_list_define(p, Q, gbl);
+        token_list_define(p, std::move(Q), gbl);
     }
 }
 
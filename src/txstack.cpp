@@ -20,6 +20,10 @@ namespace stack_ns {
 
 // Increases xid, makes sure that the attribute table is big enough
 auto Stack::next_xid(Xml *elt) -> Xid {
+    if (reserved_xid < reserved_end) {
+        enames[to_unsigned(reserved_xid)] = elt;
+        return reserved_xid++;
+    }
     attributes.emplace_back();
     enames.push_back(elt);
     last_xid++;
@@ -29,8 +33,10 @@ auto Stack::next_xid(Xml *elt) -> Xid {
 Stack::Stack() {
     attributes.reserve(2048);
     enames.reserve(2048);
-    last_xid = -1;
-    xid_boot = 0;
+    last_xid     = -1;
+    xid_boot     = 0;
+    reserved_xid = 0;
+    reserved_end = 0;
     next_xid(nullptr); // 0
     next_xid(nullptr); // 1 <document>
     next_xid(nullptr); // 2 dummy, see Stack::temporary
@@ -40,6 +46,28 @@ Stack::Stack() {
     next_xid(nullptr); // 6 is for the glossary (see txtrees)
 }
 
+// Reserves n ids, for elements created later; returns the first one.
+auto Stack::reserve_xids(long n) -> long {
+    auto res = last_xid + 1;
+    for (long i = 0; i < n; i++) next_xid(nullptr);
+    return res;
+}
+
+// Until end_reserved_xids, next_xid returns the n ids starting at a,
+// reserved by reserve_xids; last_xid is unchanged.
+void Stack::use_reserved_xids(long a, long n) {
+    reserved_xid = a;
+    reserved_end = a + n;
+}
+
+// Returns the number of reserved ids left unused.
+auto Stack::end_reserved_xids() -> long {
+    auto res     = reserved_end - reserved_xid;
+    reserved_xid = 0;
+    reserved_end = 0;
+    return res;
+}
+
 // Debug: this prints all elements, except those allocated at boot
 void Stack::dump_xml_table() {
     auto k = enames.size();
@@ -575,19 +603,19 @@ void Stack::delete_table_atts() {
 }
 
 // Adds a new <u>, <v>, and att-list slot
-void ArrayInfo::add_uv(TokenList &u, TokenList &v, const AttList &At) {
-    u_table.push_back(u);
-    v_table.push_back(v);
+void ArrayInfo::add_uv(TokenList &&u, TokenList &&v, const AttList &At) {
+    u_table.emplace_back(std::move(u));
+    v_table.emplace_back(std::move(v));
     attribs.push_back(At);
 }
 
 // This gets u-part or v-part
-auto ArrayInfo::get_u_or_v(bool u_or_v, size_t pos) const -> TokenList {
-    if (pos >= attribs.size()) return TokenList();
+auto ArrayInfo::get_u_or_v(bool u_or_v, size_t pos) const -> SharedTokenList {
+    if (pos >= attribs.size()) return SharedTokenList();
     return u_or_v ? u_table[pos] : v_table[pos];
 }
 
-auto Stack::get_u_or_v(bool u_or_v) -> TokenList {
+auto Stack::get_u_or_v(bool u_or_v) -> SharedTokenList {
     Xid        unused;
     ArrayInfo *A       = get_my_table(unused);
     auto       cell_no = A->cell_no;
@@ -16,8 +16,8 @@
 
 // Array management
 class ArrayInfo {
-    std::vector<AttList>   attribs; // positions attributes for each row
-    std::vector<TokenList> u_table, v_table;
+    std::vector<AttList>         attribs; // positions attributes for each row
+    std::vector<SharedTokenList> u_table, v_table;
 
 public:
     Xid    id;         // the id of the table
@@ -26,8 +26,8 @@ public:
     ArrayInfo(Xid a1) : id(a1) {}
 
     [[nodiscard]] auto get_cell_atts(size_t k) const -> AttList;
-    [[nodiscard]] auto get_u_or_v(bool u_or_v, size_t pos) const -> TokenList;
-    void               add_uv(TokenList &u, TokenList &v, const AttList &At);
+    [[nodiscard]] auto get_u_or_v(bool u_or_v, size_t pos) const -> SharedTokenList;
+    void               add_uv(TokenList &&u, TokenList &&v, const AttList &At);
 };
 
 // This is the stack
@@ -49,6 +49,8 @@ class Stack {
 private:
     long                   last_xid; // id of the last
     long                   xid_boot;
+    long                   reserved_xid; // next reserved id to use, see use_reserved_xids
+    long                   reserved_end; // end of the reserved ids in use
     Istring                cur_lid;    // the id to be pushed on uids[]
     std::vector<AttList>   attributes; // the main table of attributes
     std::vector<Xml *>     enames;     // the main table of element names
@@ -101,7 +103,7 @@ public:
     auto               get_cur_par() -> Xml *;
     [[nodiscard]] auto get_mode() const -> mode { return cur_mode; }
     auto               get_my_table(Xid &cid) -> ArrayInfo *;
-    auto               get_u_or_v(bool u_or_v) -> TokenList;
+    auto               get_u_or_v(bool u_or_v) -> SharedTokenList;
     auto               get_xid() -> Xid { return last_xid; }
     void               hack_for_hanl();
     void               implement_cit(const std::string &b1, Istring b2, const std::string &a, const std::string &c);
@@ -143,6 +145,9 @@ public:
     void               set_no_mode() { cur_mode = mode_none; }
     void               set_v_mode() { cur_mode = mode_v; }
     void               set_xid_boot() { xid_boot = last_xid; }
+    auto               reserve_xids(long n) -> long;
+    void               use_reserved_xids(long a, long n);
+    auto               end_reserved_xids() -> long;
     void               T_ampersand();
     void               T_hline();
     auto               temporary() -> Xml *;
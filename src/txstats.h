@@ -16,6 +16,7 @@ class Stats {
     int stb_alloc{0};                   // number of buffer realloc
     int st_nb_string{0};                // number of strings created
     int nb_macros{0}, nb_macros_del{0}; // number of macross added end deleted
+    int nb_macros_shared{0};            // number of macros replaced by an identical one
     int level_up{0}, level_down{0};     // number of push and pop nest.
     int sh_boot{0}, sh_find{0}, sh_used{0};
     int nb_ref{0}, nb_used_ref{0}, nb_label_defined{0};
@@ -43,6 +44,7 @@ public:
     }
     void one_more_macro() { nb_macros++; }
     void one_less_macro() { nb_macros_del++; }
+    void one_more_shared_macro() { nb_macros_shared++; }
     void one_more_up() { level_up++; }
     void one_more_down() { level_down++; }
     void after_boot() { sh_boot = sh_find; }
@@ -10,32 +10,46 @@
 // (See the file COPYING in the main directory for details)
 
 #include "txbuffer.h"
+#include <memory>
 
 // This file holds the hash table, and XML.
 class LabelInfo;
 
-// The string_hash table. It is like the hashtable below (Text and Next)
-// but it is extensible (maybe, we should make the hashtable extensible)
+// The string_hash table. It is like the hashtable (Text and Index), and is
+// extensible: a string gets the next location when first seen, the vectors
+// grow geometrically, and Index (open addressing, FNV-1a hash codes) is
+// rehashed when half full. Locations 0, 1 and 2 are the null string, the
+// empty string and a space. The characters of the strings are in an arena.
 // Each item has a pointer to a LabelInfo element. If the pointer is not null
 // we consider the slot of `foo', that has a \label{foo} or \ref{foo}
 // At bootstrap, we fill the table with true, false, spacebefore, center,...
 // This uses utf8 encoding. The token can be dumped via its Value
-// which can be ascii, utf8 or latin1 (XML syntax)
+// which can be ascii, utf8 or latin1 (XML syntax); it is computed
+// when first needed.
 
 class StrHash {
-    String *    Text;      // the Text table
-    String *    Value;     // the Value table
-    size_t *    Next;      // the Next table \todo size_t
-    LabelInfo **Labinfo;   // the LabelInfo
-    size_t      hash_len;  // size of the table
-    size_t      hash_last; // last slot used
-    Buffer      mybuf;     // local buffer
+    static constexpr size_t chunk_size = 1 << 16;
+    static constexpr size_t max_block  = chunk_size / 4;
+
+    std::vector<String>                  Text;               // the Text table
+    std::vector<String>                  Value;              // the Value table, null if not yet computed
+    std::vector<size_t>                  Hash;               // the hash codes
+    std::vector<LabelInfo *>             Labinfo;            // the LabelInfo
+    std::vector<uint32_t>                Index;              // the open addressing table
+    size_t                               mask{};             // size of Index minus one
+    std::vector<std::unique_ptr<char[]>> arena;              // the chunks of the arena
+    char *                               arena_ptr{nullptr}; // first free char in the current chunk
+    size_t                               arena_left{0};      // number of free chars there
+    Buffer                               mybuf;              // local buffer
+    Buffer                               outbuf;             // buffer for the Value table
+
+    auto new_string(const Buffer &B) -> String;
+    void rehash();
+
 public:
     StrHash();
 
-    [[nodiscard]] auto p_str(size_t k) const -> String { return Value[k]; }
-
-    void re_alloc();
+    auto p_str(size_t k) -> String;
     auto hash_find() -> size_t;
     auto find(String s) -> size_t;
     auto find(const std::string &s) -> size_t;
@@ -548,7 +548,7 @@ auto tpage_ns::begins_with(const std::string &A, String B) -> bool {
 }
 
 // True if current line starts with x.
-auto Clines::starts_with(String x) const -> bool { return tpage_ns::begins_with(chars, x); }
+auto Clines::starts_with(String x) const -> bool { return chars().substr(0, strlen(x)) == x; }
 
 // This compares a Begin line with the string s.
 // Returns : 0 not a begin; 1 not this type; 2 not this object
@@ -783,7 +783,7 @@ void LinePtr::find_top_atts(Buffer &B) {
     auto C = cbegin();
     auto E = cend();
     while (C != E) { // \todo this should be an STL algorithm
-        B << bf_reset << C->chars;
+        B << bf_reset << C->chars();
         B.find_top_atts();
         C = skip_env(C, B);
     }
@@ -796,7 +796,7 @@ void LinePtr::find_all_types(std::vector<std::string> &res) {
     auto    E = cend();
     while (C != E) {
         init_file_pos = C->number;
-        B << bf_reset << C->chars;
+        B << bf_reset << C->chars();
         B.find_one_type(res);
         C = skip_env(C, B);
     }
@@ -808,7 +808,7 @@ auto LinePtr::find_top_val(String s, bool c) -> std::string {
     auto    C = cbegin();
     auto    E = cend();
     while (C != E) {
-        B << bf_reset << C->chars;
+        B << bf_reset << C->chars();
         String res = B.see_config_kw(s, c);
         if (res != nullptr) return res;
         C = skip_env(C, B);
@@ -861,7 +861,7 @@ auto LinePtr::skip_env(line_iterator_const C, Buffer &B) -> line_iterator_const
     if (b != 1) return C;
     auto E = end();
     while (C != E) {
-        B << bf_reset << C->chars;
+        B << bf_reset << C->chars();
         ++C;
         b += B.see_config_env();
         if (b == 0) return C;
@@ -961,7 +961,7 @@ auto LinePtr::find_aliases(const std::vector<std::string> &SL, std::string &res)
     auto    E        = cend();
     bool    in_alias = false;
     while (C != E) {
-        B << bf_reset << C->chars;
+        B << bf_reset << C->chars();
         if (in_alias) {
             if (B.find_alias(SL, res)) return true;
         }
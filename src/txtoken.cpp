@@ -31,10 +31,12 @@ void Stats::token_stats() {
     if (nb_hdr != 0) main_ns::log_or_tty << "Number of HdR: " << nb_hdr << ".\n";
     main_ns::log_or_tty << "Buffer realloc " << stb_alloc << ", string " << st_nb_string << ", size " << static_cast<int>(str_length)
                         << ", merge " << m_merge << "\n"
-                        << "Macros created " << nb_macros << ", deleted " << nb_macros_del << "; hash size "
+                        << "Macros created " << nb_macros << ", shared " << nb_macros_shared << ", deleted " << nb_macros_del << "; hash size "
                         << the_parser.hash_table.hash_usage << " + " << the_parser.hash_table.hash_bad << "; foonotes " << footnotes
                         << ".\n"
                         << "Save stack +" << level_up << " -" << level_down << ".\n"
+                        << "Node pool: hits " << NodePool::hits << ", misses " << NodePool::misses << ", peak " << NodePool::peak
+                        << " blocks.\n"
                         << "Attribute list search " << sh_find << "(" << sh_boot << ") found " << sh_used << " in "
                         << static_cast<int>(the_main->the_stack->get_xid().value) << " elements (" << static_cast<int>(nb_xboot)
                         << " at boot).\n"
@@ -127,25 +129,24 @@ void token_ns::replace(TokenList &A, Token x1, Token x2) {
 // a single occurence.
 auto token_ns::replace_space(TokenList &A, Token x2, Token x3) -> int {
     remove_first_last_space(A);
-    auto C             = A.begin();
-    auto E             = A.end();
-    int  bl            = 0;
-    int  n             = 0;
-    bool prev_is_space = false;
-    while (C != E) {
-        Token x = *C;
+    TokenList res;
+    int       bl            = 0;
+    int       n             = 0;
+    bool      prev_is_space = false;
+    for (Token x : A) {
         check_brace(x, bl);
         if (bl == 0 && x.is_space_token()) {
             if (!prev_is_space) {
-                A.insert(C, x2);
-                *C = x3;
+                res.push_back(x2);
+                x = x3;
                 ++n;
             }
             prev_is_space = true;
         } else
             prev_is_space = false;
-        ++C;
+        res.push_back(x);
     }
+    A.swap(res);
     return n;
 }
 
@@ -160,101 +161,74 @@ auto Token::no_case_letter(char x) const -> bool {
 
 // The hash table  --------------------------------------------------
 
-// Given a string s, with hash code p, we have p<hash_prime. In the good case,
-// thhe string is at location p, otherwise at next(p), next(next(p)), etc.
-// The idea is to use locations after hash prime. This means that all strings in
-// the list has hash code p. If there is not enough room, we may use a location q
-// less then hash prime. This means that, when looking for s string s' with
-// hash code q we may encourer strings with hash code p.
-// Note: initially Next[p] is zero; if non-zero the Text[Next[p]] is non-empty.
+// Returns the position in Index of the name with hash code h, for which
+// same is true, or the position of the empty slot where it should be added.
+template <typename F> auto Hashtab::find_slot(size_t h, F same) const -> size_t {
+    for (auto i = h & mask;; i = (i + 1) & mask) {
+        auto k = Index[i];
+        if (k == 0) return i;
+        if (Hash[k - 1] == h && same(Text[k - 1])) return i;
+    }
+}
 
-// Finds an empty slot in the hash table; fills it with name s.
-// Return value is hash_used
+// Gives a location to the string s, with hash code h, and an entry in eqtb.
 // The string s must be a permanent string
-auto Hashtab::find_empty(String s) -> size_t {
-    for (;;) {
-        hash_used--;
-        if (hash_used <= 0) {
-            log_and_tty << "Size of hash table is " << hash_size << "\n";
-            log_and_tty << "Value of hash_prime is " << hash_prime << "\n";
-            log_and_tty << "hash table full\n" << lg_fatal;
-            abort();
-        }
-        if (Text[hash_used] == nullptr) break;
-    }
-    Text[hash_used] = s;
-    hash_bad++;
-    return hash_used;
+auto Hashtab::new_location(String s, size_t h) -> size_t {
+    auto p = Text.size();
+    Text.push_back(s);
+    Hash.push_back(h);
+    auto n = eqtb.size();
+    eqtb.resize(p + 1 + hash_offset - eqtb_offset);
+    for (auto i = n; i < eqtb.size(); i++) eqtb[i].reset();
+    return p;
 }
 
-// unused, kept for debug
-// void Hashtab::dump()
-// {
-//   for(int i=0;i<hash_size;i++) {
-//     if(Text[i])std::cout<< i << " " << Text[i] << "\n";
-//   }
-// }
+// Doubles the size of Index. Locations are unchanged.
+void Hashtab::rehash() {
+    std::vector<uint32_t> old(2 * Index.size(), 0);
+    Index.swap(old);
+    mask     = Index.size() - 1;
+    hash_bad = 0;
+    for (auto k : old) {
+        if (k == 0) continue;
+        auto h = Hash[k - 1];
+        auto i = h & mask;
+        while (Index[i] != 0) i = (i + 1) & mask;
+        if (i != (h & mask)) hash_bad++;
+        Index[i] = k;
+    }
+}
 
 // Returns the hash location of the name in the buffer.
 // If a new slot has to be created, uses the string name, if not empty.
 // The string name must be a permanent string
 auto Hashtab::hash_find(const Buffer &b, String name) -> size_t {
-    auto p = b.hashcode(hash_prime);
-    for (;;) {
-        if ((Text[p] != nullptr) && (b == Text[p])) return p;
-        if (Next[p] != 0)
-            p = Next[p];
-        else
-            break;
+    auto h = hash_code(b.c_str());
+    auto i = find_slot(h, [&b](String T) { return b == T; });
+    if (Index[i] != 0) {
+        auto p = Index[i] - 1;
+        if (l3_autoload && eqtb[p + hash_offset - eqtb_offset].is_undef()) load_latex3_for(Text[p]);
+        return p;
     }
     if (name == nullptr) name = b.convert_to_str();
-    return find_aux(p, name);
-}
-
-// Finds the object in the buffer B.
-auto Hashtab::hash_find() -> size_t {
-    auto p = B.hashcode(hash_prime);
-    for (;;) {
-        if ((Text[p] != nullptr) && (B == Text[p])) return p;
-        if (Next[p] != 0)
-            p = Next[p];
-        else
-            break;
-    }
-    return find_aux(p, B.convert_to_str());
-}
-
-// This inserts name in the hash table.
-// If Text[p] is empty, then p is not Next[q] so p is the hash code of s
-// non empty, use this position. Otherwise find an empty position,
-// and set Next[p] to this position.
-auto Hashtab::find_aux(size_t p, String name) -> size_t {
-    if (Text[p] != nullptr) {
-        auto q  = find_empty(name);
-        Next[p] = q;
-        return q;
-    }
+    auto p   = new_location(name, h);
+    Index[i] = static_cast<uint32_t>(p + 1);
     hash_usage++;
-    Text[p] = name;
+    if (i != (h & mask)) hash_bad++;
+    if (2 * to_unsigned(hash_usage) > Index.size()) rehash();
+    if (l3_autoload) load_latex3_for(name);
     return p;
 }
 
+// Finds the object in the buffer B.
+auto Hashtab::hash_find() -> size_t { return hash_find(B, nullptr); }
+
 // Defines the command named a, but hash_find will not find it.
 // The string a must be a permanent string
 // This must be used at bootstrap code.
 auto Hashtab::nohash_primitive(String a, CmdChr b) -> Token {
-    hash_used--;
-    auto p = hash_used;
-    if ((Text[p] != nullptr) || p < hash_prime) {
-        log_and_tty << "Size of hash table is " << hash_size << "\n";
-        log_and_tty << "Value of hash_prime is " << hash_prime << "\n";
-        log_and_tty << "Current position is " << to_signed(p) << "\n";
-        log_and_tty << "Bug in nohash_primitive\n" << lg_fatal;
-        abort();
-    }
-    hash_bad++;
-    Text[p] = a;
-    auto t  = p + hash_offset;
+    auto p = new_location(a, hash_code(a));
+    auto t = p + hash_offset;
     eqtb[t - eqtb_offset].special_prim(b); // allows to define an undefined command
     return Token(t);
 }
@@ -294,6 +268,26 @@ auto Hashtab::locate(const Buffer &b) -> Token {
     return Token(hash_find(b, nullptr) + hash_offset);
 }
 
+// Same as locate(const Buffer &), for the name formed by the n ascii
+// characters at s, whose hash code (see hash_step) has been computed by
+// the caller. The name is copied only if it is not yet in the table.
+auto Hashtab::locate(const codepoint *s, size_t n, size_t h) -> Token {
+    if (n == 1) return Token(s[0].value + single_offset);
+    auto i = find_slot(h, [s, n](String T) {
+        for (size_t j = 0; j < n; j++)
+            if (static_cast<uchar>(T[j]) != s[j].value) return false;
+        return T[n] == 0;
+    });
+    if (Index[i] != 0) {
+        auto p = Index[i] - 1;
+        if (l3_autoload && eqtb[p + hash_offset - eqtb_offset].is_undef()) load_latex3_for(Text[p]);
+        return Token(p + hash_offset);
+    }
+    B.reset();
+    for (size_t j = 0; j < n; j++) B.push_back(static_cast<char>(s[j].value));
+    return Token(hash_find(B, nullptr) + hash_offset);
+}
+
 // This returns true if the token associated to the string in the buffer
 // exists in the hash table and is not undefined.
 // Sets last_tok to the result
@@ -306,15 +300,10 @@ auto Hashtab::is_defined(const Buffer &b) -> bool {
         if (c.non_null())
             T = c.value + single_offset;
         else {
-            auto p = b.hashcode(hash_prime);
-            for (;;) {
-                if ((Text[p] != nullptr) && b == Text[p]) break;
-                if (Next[p] != 0)
-                    p = Next[p];
-                else
-                    return false;
-            }
-            T = p + hash_offset;
+            auto i = find_slot(hash_code(b.c_str()), [&b](String S) { return b == S; });
+            if (Index[i] == 0) return l3_autoload && load_latex3_for(b.c_str()) && is_defined(b);
+            T = Index[i] - 1 + hash_offset;
+            if (l3_autoload && eqtb[T - eqtb_offset].is_undef()) load_latex3_for(Text[Index[i] - 1]);
         }
     }
     last_tok = Token(T);
@@ -367,14 +356,76 @@ auto token_ns::compare(const TokenList &A, const TokenList &B) -> bool {
     }
 }
 
+// Ctor of a macro with n arguments; delims, if not null, is an array
+// of 10 delimiters
+Macro::Macro(size_t n, def_type t, const TokenList *delims, const TokenList &L) : nbargs(n), type(t) {
+    pack(delims, L);
+    correct_type();
+    compute_hash();
+}
+
+// Copies the delimiters and the body into the arena of the macro table,
+// and computes the failure functions of the delimiters.
+void Macro::pack(const TokenList *delims, const TokenList &body) {
+    auto n = body.size();
+    if (delims != nullptr)
+        for (size_t k = 0; k < 10; k++) n += delims[k].size();
+    auto * p   = the_parser.mac_table.new_tokens(n);
+    size_t pos = 0;
+    toks       = p;
+    for (size_t k = 0; k < 10; k++) {
+        if (delims != nullptr) {
+            p = std::copy(delims[k].begin(), delims[k].end(), p);
+            pos += delims[k].size();
+        }
+        limit[k] = static_cast<uint32_t>(pos);
+    }
+    std::copy(body.begin(), body.end(), p);
+    limit[10] = static_cast<uint32_t>(n);
+    if (limit[9] == 0) return;
+    fail = the_parser.mac_table.new_failures(limit[9]);
+    for (size_t k = 0; k < 10; k++) token_ns::failure_function((*this)[k], fail + (k == 0 ? 0 : limit[k - 1]));
+}
+
+// Computes the failure function of L (as in the Knuth-Morris-Pratt algorithm):
+// F[i] is the length of the longest proper prefix of L[0..i] that is also a
+// suffix of it. A newline token is the same as a space.
+void token_ns::failure_function(TokenSpan L, uint32_t *F) {
+    auto     A = L.begin();
+    auto     n = L.size();
+    uint32_t k = 0;
+    if (n > 0) F[0] = 0;
+    for (size_t i = 1; i < n; i++) {
+        while (k > 0 && !A[i].is_same_token(A[k])) k = F[k - 1];
+        if (A[i].is_same_token(A[k])) k++;
+        F[i] = k;
+    }
+}
+
+// Computes the hash code; a newline token is hashed as a space.
+void Macro::compute_hash() {
+    size_t h = nbargs * 16 + to_unsigned(static_cast<int>(type));
+    for (auto k : limit) h = h * 31 + k;
+    for (size_t i = 0; i < limit[10]; i++) {
+        Token t = toks[i];
+        h       = h * 1000003 + (t.is_space_token() ? space_token_val : t.val);
+    }
+    hash = h;
+}
+
 // compares two macros
 auto Macro::is_same(const Macro &aux) const -> bool {
+    if (hash != aux.hash) return false;
     if (nbargs != aux.nbargs) return false;
     if (type != aux.type) return false;
-    if (!token_ns::compare(body, aux.body)) return false;
-    for (size_t i = 0; i < 10; i++)
-        if (!token_ns::compare(delimiters[i], aux.delimiters[i])) return false;
-    return true;
+    if (limit != aux.limit) return false;
+    return std::equal(toks, toks + limit[10], aux.toks, [](Token a, Token b) { return a.is_same_token(b); });
+}
+
+// Same as is_same, but a newline token is not the same as a space.
+auto Macro::is_identical(const Macro &aux) const -> bool {
+    if (nbargs != aux.nbargs || type != aux.type || limit != aux.limit) return false;
+    return std::equal(toks, toks + limit[10], aux.toks, [](Token a, Token b) { return a.val == b.val; });
 }
 
 // Removes the external braces in {foo}, but not in {foo}{bar}.
@@ -656,7 +707,7 @@ void Buffer::push_back(const Macro &x) {
         for (size_t i = 1; i < K; i++) { *this << '#' << to_signed(i) + 1; }
     }
     if (wptr > 0 && at(wptr - 1) == '{') at(wptr - 1) = '#';
-    *this << "->" << x.body;
+    *this << "->" << x.body();
 }
 
 // Puts a macro into a buffer.
@@ -687,88 +738,78 @@ auto operator<<(FullLogger &fp, const Macro &x) -> FullLogger & {
 }
 
 // This is the Ctor of strhash.
-StrHash::StrHash() {
-    hash_len = hash_size;
-    Text     = new String[hash_len];
-    Value    = new String[hash_len];
-    Next     = new size_t[hash_len];
-    Labinfo  = new LabelInfo *[hash_len];
-    for (size_t i = 0; i < hash_len; i++) {
-        Text[i]    = nullptr;
-        Next[i]    = 0;
-        Labinfo[i] = nullptr;
-    }
-    hash_last = hash_prime + 1;
-    Text[0]   = ""; // make sure these are allocated.
-    Text[1]   = "";
-    Text[2]   = " ";
-    Value[0]  = ""; // make sure these are allocated.
-    Value[1]  = "";
-    Value[2]  = " ";
-}
-
-// This is called in case the table is too small.
-void StrHash::re_alloc() { // \todo use vectors instead of reinventing the wheel
-    auto   k  = hash_len + 10000;
-    auto * T1 = new String[k];
-    auto * T2 = new size_t[k];
-    auto **T3 = new LabelInfo *[k];
-    auto * T4 = new String[k];
-    for (size_t i = 0; i < hash_len; i++) {
-        T1[i] = Text[i];
-        T2[i] = Next[i];
-        T3[i] = Labinfo[i];
-        T4[i] = Value[i];
+StrHash::StrHash() : Index(1 << 13, 0), mask((1 << 13) - 1) {
+    Text    = {"", "", " "}; // make sure these are allocated.
+    Value   = Text;
+    Hash    = {0, 0, 0};
+    Labinfo = {nullptr, nullptr, nullptr};
+}
+
+// Copies the string in the buffer into the arena.
+auto StrHash::new_string(const Buffer &B) -> String {
+    auto n = B.size() + 1;
+    the_parser.my_stats.one_more_string(n);
+    char *res{nullptr};
+    if (n > max_block)
+        res = new char[n];
+    else {
+        if (n > arena_left) {
+            arena.push_back(std::make_unique<char[]>(chunk_size));
+            arena_ptr  = arena.back().get();
+            arena_left = chunk_size;
+        }
+        res = arena_ptr;
+        arena_ptr += n;
+        arena_left -= n;
     }
-    delete[] Text;
-    Text = T1;
-    delete[] Next;
-    Next = T2;
-    delete[] Labinfo;
-    Labinfo = T3;
-    delete[] Value;
-    Value = T4;
-    for (size_t i = hash_len; i < k; i++) {
-        Text[i]    = nullptr;
-        Next[i]    = 0;
-        Labinfo[i] = nullptr;
-        Value[i]   = nullptr;
+    memcpy(res, B.c_str(), n);
+    return res;
+}
+
+// Doubles the size of Index. Locations are unchanged.
+void StrHash::rehash() {
+    std::vector<uint32_t> old(2 * Index.size(), 0);
+    Index.swap(old);
+    mask = Index.size() - 1;
+    for (auto k : old) {
+        if (k == 0) continue;
+        auto i = Hash[k] & mask;
+        while (Index[i] != 0) i = (i + 1) & mask;
+        Index[i] = k;
     }
-    hash_len = k;
-    the_log << "Realloc str hash to " << k << "\n";
 }
 
 // Find something in the StrHash table. The buffer mybuf holds the string
 // to search. result is never zero
-auto StrHash::hash_find() -> size_t { // \todo size_t
+auto StrHash::hash_find() -> size_t {
     the_parser.my_stats.one_more_sh_find();
     if (mybuf.at(0) == 0) return 1;
-    auto p = mybuf.hashcode(hash_prime) + 3; // \todo why this +3 ???
-    for (;;) {
-        if ((Text[p] != nullptr) && mybuf == Text[p]) return p;
-        if (Next[p] != 0)
-            p = Next[p];
-        else
-            break;
-    }
-    String name  = mybuf.convert_to_str();
-    String value = mybuf.convert_to_out_encoding(name);
-    if (Text[p] == nullptr) {
-        the_parser.my_stats.one_more_sh_used();
-        Text[p]  = name;
-        Value[p] = value;
-        return p;
+    auto h = Hashtab::hash_code(mybuf.c_str());
+    auto i = h & mask;
+    for (; Index[i] != 0; i = (i + 1) & mask) {
+        auto k = Index[i];
+        if (Hash[k] == h && mybuf == Text[k]) return k;
     }
-    if (hash_last >= hash_len) re_alloc();
-    auto k = hash_last;
-    hash_last++;
     the_parser.my_stats.one_more_sh_used();
-    Text[k]  = name;
-    Value[k] = value;
-    Next[p]  = k;
+    auto k = Text.size();
+    Text.push_back(new_string(mybuf));
+    Value.push_back(nullptr);
+    Hash.push_back(h);
+    Labinfo.push_back(nullptr);
+    Index[i] = static_cast<uint32_t>(k);
+    if (2 * k > Index.size()) rehash();
     return k;
 }
 
+// Returns the value of the string at k, converted to the output encoding.
+auto StrHash::p_str(size_t k) -> String {
+    if (Value[k] == nullptr) {
+        outbuf << bf_reset << Text[k];
+        Value[k] = outbuf.convert_to_out_encoding(Text[k]);
+    }
+    return Value[k];
+}
+
 // The string can be a temporary
 auto StrHash::find(String s) -> size_t {
     mybuf << bf_reset << s;
@@ -1515,6 +1515,7 @@ auto CmdChr::token_assignint_name() const -> String {
     case lastlinefit_code: return "lastlinefit";
     case savingdiscards_code: return "savingdiscards";
     case savinghyphcodes_code: return "savinghyphcodes";
+    case catcodetable_code: return "catcodetable";
     default:
         if (chr < math_code_offset) return make_name("catcode", chr);
         if (chr < lc_code_offset) return make_name("mathcode", chr - math_code_offset);
@@ -2787,6 +2788,7 @@ auto CmdChr::name() const -> String {
     case add_to_macro_cmd: return chr == 1 ? "tralics@addtolist@o" : "tralics@addtolist@n";
     case makeatletter_cmd: return "makeatletter";
     case makeatother_cmd: return "makeatother";
+    case catcode_table_cmd: return chr == 1 ? "savecatcodetable" : "initcatcodetable";
     case numberedverbatim_cmd: return "numberedverbatim";
     case unnumberedverbatim_cmd: return "unnumberedverbatim";
     case after_assignment_cmd: return "afterassignment";
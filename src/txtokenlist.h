@@ -11,12 +11,14 @@
 
 #include "tralics/Istring.h"
 #include "tralics/Token.h"
+#include <memory>
+#include <unordered_map>
 #include <utility>
 
 class FpNum;
 class Hashtab;
 
-using token_iterator = std::list<Token>::iterator;
+using token_iterator = TokenList::iterator;
 
 namespace token_ns {
     void add_env(TokenList &L, String name);
@@ -25,6 +27,7 @@ namespace token_ns {
     auto block_size(const TokenList &L) -> int;
     void expand_nct(TokenList &);
     auto expand_nct(TokenList &L, size_t n, uchar c, int &MX, TokenList &body) -> bool;
+    void failure_function(TokenSpan L, uint32_t *F);
     void expand_star(TokenList &L);
     auto fast_get_block(TokenList &L) -> TokenList;
     void fast_get_block(TokenList &L, TokenList &res);
@@ -101,35 +104,117 @@ public:
     void               push_upn(FpNum x);
 };
 
-// This represents the value of a user-defined command
+// This represents the value of a user-defined command. The delimiters (the
+// tokens that follow #k in the parameter text, k=0 for those before #1) and
+// the body are stored one after the other in a single array, allocated in
+// the arena of the macro table. Delimiter k is toks[limit[k-1], limit[k]),
+// the body is toks[limit[9], limit[10]). The failure functions of the
+// delimiters, used by scan_group_del, are precomputed, and stored in the
+// same way in fail, allocated in the other arena of the macro table (it
+// has limit[9] entries). A macro never changes once built, so that identical definitions can share a slot in the table;
+// the hash code is used for this, and for \ifx (where newline and space are
+// the same).
 class Macro {
-    std::array<TokenList, 10> delimiters; // delimiters between arguments
+    friend class Mactab;
+    Token *                  toks{nullptr}; // delimiters and body
+    uint32_t *               fail{nullptr}; // failure functions of the delimiters
+    std::array<uint32_t, 11> limit{};       // end of each delimiter, end of body
+    size_t                   hash{0};       // hash code of the macro
+
+    void pack(const TokenList *delims, const TokenList &body);
+    void compute_hash();
+
 public:
-    size_t    nbargs{0};       // number of arguments
-    def_type  type{dt_normal}; // type of macro
-    TokenList body;            // the body
+    size_t   nbargs{0};       // number of arguments
+    def_type type{dt_normal}; // type of macro
 
     Macro() = default;
-    Macro(TokenList L) : body(std::move(L)) { correct_type(); }
+    explicit Macro(const TokenList &L) {
+        pack(nullptr, L);
+        correct_type();
+        compute_hash();
+    }
+    Macro(size_t n, def_type t, const TokenList *delims, const TokenList &L);
+    Macro(const Macro &) = delete;
+    auto operator=(const Macro &) -> Macro & = delete;
 
-    void               set_nbargs(size_t n) { nbargs = n; } // \todo remove
-    void               set_type(def_type n) { type = n; }
     [[nodiscard]] auto is_same(const Macro &aux) const -> bool;
-    auto               operator[](size_t n) const -> const TokenList & { return delimiters[n]; }
-    void               set_delimiters(size_t k, TokenList L) { delimiters[k] = std::move(L); }
+    [[nodiscard]] auto is_identical(const Macro &aux) const -> bool;
+    [[nodiscard]] auto body() const -> TokenSpan { return {toks + limit[9], toks + limit[10]}; }
+    auto               operator[](size_t n) const -> TokenSpan { return {toks + (n == 0 ? 0 : limit[n - 1]), toks + limit[n]}; }
+    [[nodiscard]] auto failure(size_t n) const -> const uint32_t * { return fail + (n == 0 ? 0 : limit[n - 1]); }
     void               correct_type();
 };
 
+// An arena: a list of chunks that are filled one after the other, by blocks
+// of a multiple of 4 objects. A block that is given back is put in a free
+// list, and reused by the next request of the same size. A large block is
+// allocated outside the arena.
+template <typename T> class MacArena {
+    static constexpr size_t chunk_size = 1 << 14;
+    static constexpr size_t max_block  = chunk_size / 4;
+
+    std::vector<std::unique_ptr<T[]>> chunks;       // the chunks of the arena
+    T *                               cur{nullptr}; // first free object in the current chunk
+    size_t                            left{0};      // number of free objects there
+    std::vector<std::vector<T *>>     free_blocks;  // free blocks, by size/4
+
+public:
+    auto get(size_t n) -> T *;
+    void give_back(T *p, size_t n);
+};
+
+// Returns room for n objects.
+template <typename T> auto MacArena<T>::get(size_t n) -> T * {
+    if (n == 0) return nullptr;
+    if (n > max_block) return new T[n];
+    auto k = (n + 3) / 4;
+    if (k < free_blocks.size() && !free_blocks[k].empty()) {
+        auto *res = free_blocks[k].back();
+        free_blocks[k].pop_back();
+        return res;
+    }
+    n = 4 * k;
+    if (n > left) {
+        chunks.push_back(std::make_unique<T[]>(chunk_size));
+        cur  = chunks.back().get();
+        left = chunk_size;
+    }
+    auto *res = cur;
+    cur += n;
+    left -= n;
+    return res;
+}
+
+// Gives back the block p, obtained by get(n).
+template <typename T> void MacArena<T>::give_back(T *p, size_t n) {
+    if (n > max_block)
+        delete[] p;
+    else if (n != 0) {
+        auto k = (n + 3) / 4;
+        if (k >= free_blocks.size()) free_blocks.resize(k + 1);
+        free_blocks[k].push_back(p);
+    }
+}
+
 // The table of macros. it contains the reference counts
 // Consider: \def\mac{\def\mac{a} b}. When mac is expanded, its body is copied
 // when the inner \def is executed, then \mac is destroyed (if nobody else
 // points to it, i.e. if the reference count is zero)
+// The tokens of the macros are in an arena, the failure functions of their
+// delimiters in another one; when a macro is killed, its blocks are given
+// back.
+// A new macro identical to an existing one is replaced by it; so that
+// \def\@tempa{foo} executed many times uses a single slot.
 class Mactab {
 private:
-    Macro **table{nullptr};    // this contains the table
-    long *  rc_table{nullptr}; // this contains the reference counts
-    size_t  cur_rc_mac_len{0}; // size of the table.
-    long    ptr{-1};           // pointer to the first free position
+    Macro **                              table{nullptr};    // this contains the table
+    long *                                rc_table{nullptr}; // this contains the reference counts
+    size_t                                cur_rc_mac_len{0}; // size of the table.
+    long                                  ptr{-1};           // pointer to the first free position
+    MacArena<Token>                       tokens;            // the tokens of the macros
+    MacArena<uint32_t>                    failures;          // the failure functions of the delimiters
+    std::unordered_multimap<size_t, long> interned;          // hash code to slot
 private:
     void rc_mac_realloc();
 
@@ -140,4 +225,7 @@ public:
     void delete_macro_ref(int i);
     auto get_macro(int k) -> Macro & { return *table[k]; }
     auto new_macro(Macro *s) -> subtypes;
+    auto new_tokens(size_t n) -> Token * { return tokens.get(n); }
+    auto new_failures(size_t n) -> uint32_t * { return failures.get(n); }
+    void delete_macro(Macro *X);
 };
@@ -58,12 +58,16 @@ public:
 std::vector<ColSpec *> all_colors;
 
 // This code translates everything, until end of file.
+// After a character, the rest of the word is handled by translate_char_run
+// when it can be read directly from the input line.
 void Parser::translate_all() {
     unprocessed_xml.reset();
     for (;;) {
         if (get_x_token()) break;
         if (tracing_commands()) translate02();
         translate01();
+        if (cur_cmd_chr.is_letter_other() && TL.empty() && !restricted && the_stack.in_h_mode() && !tracing_commands())
+            translate_char_run();
     }
     flush_buffer();
 }